@@ -1,5 +1,9 @@
 #pragma once
 
+#ifndef BUILD_HEADLESS
+#define BUILD_HEADLESS 0
+#endif
+
 // Virtual resolution used by game/UI coordinates.
 #define APP_USE_VIRTUAL_RES true
 #define APP_VIRTUAL_WIDTH (1024)
@@ -7,6 +11,30 @@
 
 // Runtime defaults.
 #define APP_MAX_FRAME_RATE (60.0f)
+#define APP_FRAME_PACING_MODE (Engine::FramePacingMode::Fixed)
+
+// Fixed-step simulation rate, and how far it may fall behind before time is dropped.
+#define APP_FIXED_STEP_RATE (1000.0f)
+#define APP_MAX_FIXED_STEPS_PER_FRAME (1000)
 #define APP_INIT_WINDOW_WIDTH (APP_VIRTUAL_WIDTH)
 #define APP_INIT_WINDOW_HEIGHT (APP_VIRTUAL_HEIGHT)
 #define APP_WINDOW_TITLE ("Game")
+
+// Gamepads are polled at this rate while the frame pacer waits, so their edges are stamped
+// within a poll period rather than a frame. Polling stays on the event thread.
+#define APP_INPUT_WAIT_POLL_ENABLED (true)
+#define APP_INPUT_POLL_RATE_HZ (1000.0f)
+
+// Headless runs: no window or audio device, and a virtual clock that advances one frame per loop.
+// Also enabled per run with --headless.
+#define APP_HEADLESS_DEFAULT (BUILD_HEADLESS != 0)
+#define APP_HEADLESS_FRAME_RATE (60.0f)
+#define APP_HEADLESS_AUDIO_SAMPLE_RATE (48000)
+
+// Stress harness (--stress): autoplays every song in every HUD and timing target mode.
+// A case over any budget fails the run with a non-zero exit code.
+#define APP_STRESS_FRAME_RATE (60.0f)
+#define APP_STRESS_CASE_SECONDS (20.0f)
+#define APP_STRESS_FRAME_BUDGET_MS (4.0f)
+#define APP_STRESS_MAX_LIVE_NOTES (256)
+#define APP_STRESS_MAX_GHOSTS (300)
@@ -3,9 +3,13 @@
 #include <cassert>
 
 #include "miniaudio/miniaudio.h"
+#include "Config/AppConfig.h"
 
 namespace Engine
 {
+    static constexpr ma_uint32 headless_channels = 2;
+    static constexpr ma_uint64 headless_chunk_frames = 1024;
+
     static bool HasFlag(const SoundFlags flags, const SoundFlags test)
     {
         return (static_cast<unsigned>(flags) & static_cast<unsigned>(test)) != 0;
@@ -27,18 +31,47 @@ namespace Engine
         }
     }
 
-    bool AudioPlayer::Initialize()
+    bool AudioPlayer::Initialize(const bool use_device)
     {
         if (m_initialized) return true;
 
+        ma_engine_config config = ma_engine_config_init();
+        if (!use_device)
+        {
+            // no device to ask, so the format has to be given
+            config.noDevice = MA_TRUE;
+            config.channels = headless_channels;
+            config.sampleRate = APP_HEADLESS_AUDIO_SAMPLE_RATE;
+        }
+
         m_engine = new ma_engine();
-        const ma_result result = ma_engine_init(nullptr, m_engine);
+        const ma_result result = ma_engine_init(&config, m_engine);
         assert(result == MA_SUCCESS);
 
+        m_use_device = use_device;
+        m_headless_frame_remainder = 0.0;
         m_initialized = (result == MA_SUCCESS);
         return m_initialized;
     }
 
+    void AudioPlayer::AdvanceHeadless(const double seconds)
+    {
+        if (!m_initialized || m_use_device || seconds <= 0.0) return;
+
+        // pull the mix forward so sounds play out and end as they would on a device
+        m_headless_frame_remainder += seconds * static_cast<double>(APP_HEADLESS_AUDIO_SAMPLE_RATE);
+        ma_uint64 frames_left = static_cast<ma_uint64>(m_headless_frame_remainder);
+        m_headless_frame_remainder -= static_cast<double>(frames_left);
+
+        static float scratch[headless_chunk_frames * headless_channels];
+        while (frames_left > 0)
+        {
+            const ma_uint64 chunk = (frames_left < headless_chunk_frames) ? frames_left : headless_chunk_frames;
+            (void)ma_engine_read_pcm_frames(m_engine, scratch, chunk, nullptr);
+            frames_left -= chunk;
+        }
+    }
+
     void AudioPlayer::ClearSounds()
     {
         for (auto& pair : m_sounds)
@@ -20,9 +20,12 @@ namespace Engine
     public:
         static AudioPlayer& Get();
 
-        bool Initialize();
+        // without a device the mix only advances through AdvanceHeadless
+        bool Initialize(bool use_device = true);
         void Shutdown();
 
+        void AdvanceHeadless(double seconds);
+
         bool Play(const char* filename, SoundFlags flags);
         bool Stop(const char* filename);
         bool IsPlaying(const char* filename) const;
@@ -52,5 +55,7 @@ namespace Engine
         ma_engine* m_engine = nullptr;
         std::map<std::string, SoundEntry> m_sounds;
         bool m_initialized = false;
+        bool m_use_device = true;
+        double m_headless_frame_remainder = 0.0;
     };
 }
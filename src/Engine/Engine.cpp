@@ -5,20 +5,137 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////
 #include "Engine.h"
 #include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
 #include <SDL3/SDL.h>
 #include "AudioPlayer.h"
+#include "GamepadMapping.h"
 
 namespace Engine
 {
     static SDL_Window* window = nullptr;
     static SDL_Renderer* renderer = nullptr;
 
+    static RuntimeOptions g_options;
+    static int g_argc = 0;
+    static char** g_argv = nullptr;
+    static bool g_quit_requested = false;
+    static int g_exit_code = 0;
+
+    //////////////
+    // Headless //
+    /////////////////////////////////////////////////////////////
+    // No window: the renderer is either absent (batches are   //
+    // only counted) or a software one over an offscreen       //
+    // surface. Time comes from a virtual clock that moves one //
+    // frame per loop, so runs go as fast as the CPU allows.   //
+    /////////////////////////////////////////////////////////////
+    static SDL_Surface* g_headless_surface = nullptr;
+    static uint64_t g_virtual_clock_ns = 0;
+    static uint64_t g_headless_frame_ns = 0;
+    static uint64_t g_frames_run = 0;
+    static uint64_t g_wall_start_ns = 0;
+    static uint64_t g_total_draw_calls = 0;
+
     static constexpr int max_controllers = 4;
     static Controller g_controllers[max_controllers];
 
+    //////////////////
+    // Gamepad slot //
+    ///////////////////////////////////////////////////////////
+    // Handles stay open from ADDED to REMOVED; state is fed //
+    // by SDL gamepad events, all on the event thread        //
+    ///////////////////////////////////////////////////////////
+    static constexpr int pad_axis_count = 6;
+
+    struct PadSlot
+    {
+        SDL_Gamepad* handle = nullptr;
+        SDL_JoystickID id = 0;
+        uint32_t held = 0;
+        uint32_t tapped = 0;
+        int16_t axes[pad_axis_count] = {};
+    };
+    static PadSlot g_pad_slots[max_controllers];
+
+    static uint32_t g_pad_polls = 0;
+
+    // run by the pacer while a frame waits, on this (the event) thread: SDL
+    // queues pad events stamped at this poll, and the next pump reads them
+    static void PollGamepads()
+    {
+        SDL_UpdateGamepads();
+        ++g_pad_polls;
+    }
+
     static constexpr int key_count = static_cast<int>(KEY_COUNT);
     static uint8_t current_key[key_count] = {};
     static uint8_t previous_key[key_count] = {};
+    static Key key_for_scancode[SDL_SCANCODE_COUNT] = {};
+
+    static constexpr int max_input_events = 64;
+    static InputEvent g_input_events[max_input_events];
+    static int g_input_event_count = 0;
+    static uint64_t g_input_timestamp_ns = 0;
+
+    static FramePacer g_pacer;
+
+    ////////////////////
+    // Geometry batch //
+    /////////////////////////////////////////////////////////////
+    // Triangles and lines append here and go out as a single  //
+    // SDL_RenderGeometry when something else has to draw, the //
+    // frame ends, or the batch fills.                         //
+    /////////////////////////////////////////////////////////////
+    static constexpr int max_batch_vertices = 16384;
+    static constexpr int max_batch_indices = max_batch_vertices * 3;
+    static std::vector<SDL_Vertex> g_batch_vertices;
+    static std::vector<int> g_batch_indices;
+
+    //////////////
+    // Textures //
+    /////////////////////////////////////////////////////////////
+    // A slot per id, reused once destroyed. Without a         //
+    // renderer the slot has no SDL texture and draws are only //
+    // counted. Shutdown releases them before the renderer.    //
+    /////////////////////////////////////////////////////////////
+    struct TextureSlot
+    {
+        SDL_Texture* texture = nullptr;
+        int width = 0;
+        int height = 0;
+        bool in_use = false;
+    };
+    static std::vector<TextureSlot> g_textures;
+    static TextureId g_batch_texture = 0;
+
+    // texture being drawn into, and the screen height to restore after
+    static TextureId g_render_target = 0;
+    static float g_screen_height = 0.0f;
+    static uint32_t g_render_target_generation = 0;
+
+    static TextureSlot* FindTexture(TextureId texture);
+
+    static RenderStats g_render_stats;
+    static RenderStats g_frame_render_stats;
+
+    // window height is read once per frame, not once per vertex
+    static float g_window_height = 0.0f;
+
+    static uint64_t g_fixed_step_timestamp_ns = 0;
+    static float g_interpolation_alpha = 0.0f;
+
+    static InputLatencyStats g_latency_stats;
+    static uint64_t g_latency_window_start_ns = 0;
+    static uint64_t g_latency_sum_ns = 0;
+    static uint64_t g_latency_max_ns = 0;
+    static uint32_t g_latency_samples = 0;
+    static uint32_t g_latency_dropped = 0;
+
+    static SDL_Scancode ScancodeForKey(Key key);
 
     static float ToRenderX(const float x)
     {
@@ -27,16 +144,110 @@ namespace Engine
 
     static float ToRenderY(const float y)
     {
-        const float h = RuntimeGetWindowHeight();
-        return h - y;
+        return g_window_height - y;
+    }
+
+    // reserves room for a primitive, flushing first if it wouldn't fit or
+    // needs a different texture (0 for none)
+    static int BeginBatch(const int vertex_count, const int index_count, const TextureId texture = 0)
+    {
+        if (texture != g_batch_texture)
+        {
+            FlushGeometry();
+            g_batch_texture = texture;
+        }
+
+        const int base_vertex = static_cast<int>(g_batch_vertices.size());
+        if (base_vertex + vertex_count > max_batch_vertices ||
+            static_cast<int>(g_batch_indices.size()) + index_count > max_batch_indices)
+        {
+            FlushGeometry();
+            return 0;
+        }
+        return base_vertex;
+    }
+
+    static void PushBatchVertex(const float x, const float y, const float r, const float g, const float b, const float a,
+                                const float u = 0.0f, const float v = 0.0f)
+    {
+        SDL_Vertex vertex;
+        vertex.position.x = ToRenderX(x);
+        vertex.position.y = ToRenderY(y);
+        vertex.color.r = r;
+        vertex.color.g = g;
+        vertex.color.b = b;
+        vertex.color.a = a;
+        vertex.tex_coord.x = u;
+        vertex.tex_coord.y = v;
+        g_batch_vertices.push_back(vertex);
     }
 
     static void SetDrawColour(const float r, const float g, const float b, const float a)
     {
+        if (!renderer) return;
         (void)SDL_SetRenderDrawColorFloat(renderer, r, g, b, a);
     }
 
-    bool RuntimeInit()
+    static const char* FindCommandLineArg(const char* flag, const char** value)
+    {
+        const size_t flag_length = std::strlen(flag);
+        for (int i = 1; i < g_argc; i++)
+        {
+            const char* arg = g_argv[i];
+            if (std::strncmp(arg, flag, flag_length) != 0) continue;
+
+            if (arg[flag_length] == '=')
+            {
+                if (value) *value = arg + flag_length + 1;
+                return arg;
+            }
+
+            if (arg[flag_length] == '\0')
+            {
+                // only take the next arg as a value if it isn't another flag
+                if (value) *value = (i + 1 < g_argc && std::strncmp(g_argv[i + 1], "--", 2) != 0) ? g_argv[i + 1] : nullptr;
+                return arg;
+            }
+        }
+        return nullptr;
+    }
+
+    bool HasCommandLineFlag(const char* flag)
+    {
+        return FindCommandLineArg(flag, nullptr) != nullptr;
+    }
+
+    const char* GetCommandLineValue(const char* flag)
+    {
+        const char* value = nullptr;
+        return FindCommandLineArg(flag, &value) ? value : nullptr;
+    }
+
+    static void ParseRuntimeOptions()
+    {
+        g_options = RuntimeOptions{};
+
+        if (HasCommandLineFlag("--headless"))
+        {
+            g_options.headless = true;
+
+            const char* render = GetCommandLineValue("--headless");
+            if (render && std::strcmp(render, "software") == 0) g_options.headless_render = HeadlessRender::Software;
+        }
+
+        if (const char* frames = GetCommandLineValue("--frames"))
+        {
+            g_options.max_frames = std::strtoull(frames, nullptr, 10);
+        }
+
+        if (const char* rate = GetCommandLineValue("--frame-rate"))
+        {
+            const float rate_hz = std::strtof(rate, nullptr);
+            if (rate_hz > 0.0f) g_options.headless_frame_rate = rate_hz;
+        }
+    }
+
+    static bool InitWindowed()
     {
         if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_GAMEPAD | SDL_INIT_AUDIO))
         {
@@ -50,21 +261,140 @@ namespace Engine
         if (!renderer) return false;
 
         (void)SDL_SetRenderLogicalPresentation(renderer, APP_VIRTUAL_WIDTH, APP_VIRTUAL_HEIGHT, SDL_LOGICAL_PRESENTATION_LETTERBOX);
+        return true;
+    }
 
-        if (!AudioPlayer::Get().Initialize())
+    static bool InitHeadless()
+    {
+        // events only: no display, audio device or gamepads needed
+        if (!SDL_Init(SDL_INIT_EVENTS))
         {
             return false;
         }
 
+        if (g_options.headless_render == HeadlessRender::Software)
+        {
+            g_headless_surface = SDL_CreateSurface(APP_VIRTUAL_WIDTH, APP_VIRTUAL_HEIGHT, SDL_PIXELFORMAT_RGBA8888);
+            if (!g_headless_surface) return false;
+
+            renderer = SDL_CreateSoftwareRenderer(g_headless_surface);
+            if (!renderer) return false;
+        }
+
+        g_headless_frame_ns = static_cast<uint64_t>(1000000000.0 / static_cast<double>(g_options.headless_frame_rate));
+
+        // start away from zero so "unset" timestamps never match
+        g_virtual_clock_ns = 1000000000;
+        return true;
+    }
+
+    const RuntimeOptions& GetRuntimeOptions()
+    {
+        return g_options;
+    }
+
+    bool IsHeadless()
+    {
+        return g_options.headless;
+    }
+
+    void RequestQuit()
+    {
+        g_quit_requested = true;
+    }
+
+    void SetExitCode(const int exit_code)
+    {
+        g_exit_code = exit_code;
+    }
+
+    int GetExitCode()
+    {
+        return g_exit_code;
+    }
+
+    uint64_t RuntimeGetTicksNS()
+    {
+        return g_options.headless ? g_virtual_clock_ns : SDL_GetTicksNS();
+    }
+
+    bool RuntimeInit(const int argc, char** argv)
+    {
+        g_argc = argc;
+        g_argv = argv;
+        ParseRuntimeOptions();
+
+        const bool initialized = g_options.headless ? InitHeadless() : InitWindowed();
+        if (!initialized) return false;
+
+        SetFramePacing(APP_FRAME_PACING_MODE, APP_MAX_FRAME_RATE);
+
+        g_batch_vertices.reserve(max_batch_vertices);
+        g_batch_indices.reserve(max_batch_indices);
+        g_window_height = RuntimeGetWindowHeight();
+
+        if (!AudioPlayer::Get().Initialize(!g_options.headless))
+        {
+            return false;
+        }
+
+        for (int scan = 0; scan < SDL_SCANCODE_COUNT; scan++) key_for_scancode[scan] = KEY_COUNT;
+        for (int i = 0; i < key_count; i++)
+        {
+            const SDL_Scancode scan = ScancodeForKey(static_cast<Key>(i));
+            if (scan != SDL_SCANCODE_UNKNOWN) key_for_scancode[scan] = static_cast<Key>(i);
+        }
+
+        if (APP_INPUT_WAIT_POLL_ENABLED && !g_options.headless) g_pacer.SetInputPoll(&PollGamepads, APP_INPUT_POLL_RATE_HZ);
+
+        g_wall_start_ns = SDL_GetTicksNS();
+
         RuntimeTickInput();
 
         return true;
     }
 
+    static void LogHeadlessSummary()
+    {
+        if (g_frames_run == 0) return;
+
+        const double wall_sec = static_cast<double>(SDL_GetTicksNS() - g_wall_start_ns) / 1000000000.0;
+        const double simulated_sec = static_cast<double>(g_frames_run * g_headless_frame_ns) / 1000000000.0;
+        const FrameTimeStats& frame_stats = g_pacer.GetStats();
+
+        SDL_Log("headless: %llu frames, %.2fs simulated in %.2fs wall (%.1fx real time)",
+                static_cast<unsigned long long>(g_frames_run),
+                simulated_sec,
+                wall_sec,
+                wall_sec > 0.0 ? simulated_sec / wall_sec : 0.0);
+        SDL_Log("headless: frame %.3fms avg | %.3fms p99 | %.3fms max, %.1f draw calls per frame",
+                static_cast<double>(frame_stats.mean_ms),
+                static_cast<double>(frame_stats.p99_ms),
+                static_cast<double>(frame_stats.max_ms),
+                static_cast<double>(g_total_draw_calls) / static_cast<double>(g_frames_run));
+    }
+
     void RuntimeShutdown()
     {
+        if (g_options.headless) LogHeadlessSummary();
+
+        g_pacer.SetInputPoll(nullptr, 0.0f);
         AudioPlayer::Get().Shutdown();
 
+        for (int i = 0; i < max_controllers; i++)
+        {
+            if (g_pad_slots[i].handle) SDL_CloseGamepad(g_pad_slots[i].handle);
+            g_pad_slots[i] = PadSlot{};
+        }
+
+        EndRenderToTexture();
+        for (TextureSlot& slot : g_textures)
+        {
+            if (slot.texture) SDL_DestroyTexture(slot.texture);
+            slot = TextureSlot{};
+        }
+        g_batch_texture = 0;
+
         if (renderer)
         {
             SDL_DestroyRenderer(renderer);
@@ -77,34 +407,301 @@ namespace Engine
             window = nullptr;
         }
 
+        if (g_headless_surface)
+        {
+            SDL_DestroySurface(g_headless_surface);
+            g_headless_surface = nullptr;
+        }
+
         SDL_Quit();
     }
 
+    static int SlotForJoystick(const SDL_JoystickID id)
+    {
+        for (int i = 0; i < max_controllers; i++)
+        {
+            if (g_pad_slots[i].handle && g_pad_slots[i].id == id) return i;
+        }
+        return -1;
+    }
+
+    static void OpenGamepad(const SDL_JoystickID id)
+    {
+        if (SlotForJoystick(id) >= 0) return;
+
+        for (int i = 0; i < max_controllers; i++)
+        {
+            PadSlot& slot = g_pad_slots[i];
+            if (slot.handle) continue;
+
+            // pads must stay open for SDL to deliver their events
+            slot = PadSlot{};
+            slot.handle = SDL_OpenGamepad(id);
+            if (!slot.handle) return;
+            slot.id = id;
+
+            // seed from the current state; events only report changes
+            slot.held = MapButtons(slot.handle);
+            for (int axis = 0; axis < pad_axis_count; axis++)
+            {
+                slot.axes[axis] = SDL_GetGamepadAxis(slot.handle, static_cast<SDL_GamepadAxis>(axis));
+            }
+            return;
+        }
+    }
+
+    static void CloseGamepad(const SDL_JoystickID id)
+    {
+        const int slot = SlotForJoystick(id);
+        if (slot < 0) return;
+
+        SDL_CloseGamepad(g_pad_slots[slot].handle);
+        g_pad_slots[slot] = PadSlot{};
+    }
+
+    static void ApplyButtonEdge(PadSlot& slot, const uint32_t button, const bool down)
+    {
+        if (down)
+        {
+            slot.held |= button;
+            slot.tapped |= button;
+        }
+        else
+        {
+            slot.held &= ~button;
+        }
+    }
+
+    static void PushInputEvent(const InputEvent& event)
+    {
+        if (g_input_event_count >= max_input_events)
+        {
+            ++g_latency_dropped;
+            return;
+        }
+        g_input_events[g_input_event_count++] = event;
+    }
+
+    static void RecordLatency(const uint64_t now_ns, const uint64_t timestamp_ns)
+    {
+        const uint64_t latency_ns = (now_ns > timestamp_ns) ? now_ns - timestamp_ns : 0;
+        g_latency_sum_ns += latency_ns;
+        g_latency_max_ns = std::max(g_latency_max_ns, latency_ns);
+        ++g_latency_samples;
+    }
+
+    static void PublishLatency(const uint64_t now_ns)
+    {
+        if (now_ns - g_latency_window_start_ns < 1000000000) return;
+
+        g_latency_stats.samples = g_latency_samples;
+        g_latency_stats.mean_ms = g_latency_samples ? static_cast<float>(static_cast<double>(g_latency_sum_ns) / g_latency_samples / 1000000.0) : 0.0f;
+        g_latency_stats.max_ms = static_cast<float>(static_cast<double>(g_latency_max_ns) / 1000000.0);
+        g_latency_stats.poll_rate_hz = static_cast<float>(g_pad_polls / (static_cast<double>(now_ns - g_latency_window_start_ns) / 1000000000.0));
+        g_latency_stats.dropped = g_latency_dropped;
+
+        g_latency_window_start_ns = now_ns;
+        g_latency_sum_ns = 0;
+        g_latency_max_ns = 0;
+        g_latency_samples = 0;
+        g_latency_dropped = 0;
+        g_pad_polls = 0;
+    }
+
     void RuntimePumpEvents(bool& quit)
     {
+        if (g_quit_requested) quit = true;
+
+        g_input_event_count = 0;
+        for (int i = 0; i < max_controllers; i++) g_pad_slots[i].tapped = 0;
+
+        // the frame's own pump counts as a poll too
+        ++g_pad_polls;
+
         SDL_Event ev;
         while (SDL_PollEvent(&ev))
         {
-            if (ev.type == SDL_EVENT_QUIT)
+            switch (ev.type)
             {
-                quit = true;
+                case SDL_EVENT_QUIT:
+                    quit = true;
+                    break;
+
+                case SDL_EVENT_KEY_DOWN:
+                case SDL_EVENT_KEY_UP:
+                {
+                    if (ev.key.repeat || ev.key.scancode >= SDL_SCANCODE_COUNT) break;
+
+                    const Key key = key_for_scancode[ev.key.scancode];
+                    if (key == KEY_COUNT) break;
+
+                    InputEvent event{};
+                    event.type = (ev.type == SDL_EVENT_KEY_DOWN) ? InputEventType::KeyDown : InputEventType::KeyUp;
+                    event.key = key;
+                    event.timestamp_ns = ev.key.timestamp;
+                    PushInputEvent(event);
+                    break;
+                }
+
+                case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+                case SDL_EVENT_GAMEPAD_BUTTON_UP:
+                {
+                    const int slot = SlotForJoystick(ev.gbutton.which);
+                    const uint32_t button = ButtonForSdl(ev.gbutton.button);
+                    if (slot < 0 || button == 0) break;
+
+                    ApplyButtonEdge(g_pad_slots[slot], button, ev.type == SDL_EVENT_GAMEPAD_BUTTON_DOWN);
+
+                    InputEvent event{};
+                    event.type = (ev.type == SDL_EVENT_GAMEPAD_BUTTON_DOWN) ? InputEventType::ButtonDown : InputEventType::ButtonUp;
+                    event.button = button;
+                    event.pad = slot;
+                    event.timestamp_ns = ev.gbutton.timestamp;
+                    PushInputEvent(event);
+                    break;
+                }
+
+                case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+                {
+                    const int slot = SlotForJoystick(ev.gaxis.which);
+                    if (slot < 0 || ev.gaxis.axis >= pad_axis_count) break;
+
+                    g_pad_slots[slot].axes[ev.gaxis.axis] = ev.gaxis.value;
+                    break;
+                }
+
+                case SDL_EVENT_GAMEPAD_ADDED:
+                    OpenGamepad(ev.gdevice.which);
+                    break;
+
+                case SDL_EVENT_GAMEPAD_REMOVED:
+                    CloseGamepad(ev.gdevice.which);
+                    break;
+
+                case SDL_EVENT_RENDER_TARGETS_RESET:
+                case SDL_EVENT_RENDER_DEVICE_RESET:
+                    ++g_render_target_generation;
+                    break;
+
+                default:
+                    break;
             }
         }
+
+        // events are aged against the moment the frame sampled input
+        g_input_timestamp_ns = RuntimeGetTicksNS();
+
+        // keep events in press order across both sources
+        for (int i = 1; i < g_input_event_count; i++)
+        {
+            const InputEvent event = g_input_events[i];
+            int j = i;
+            for (; j > 0 && g_input_events[j - 1].timestamp_ns > event.timestamp_ns; j--) g_input_events[j] = g_input_events[j - 1];
+            g_input_events[j] = event;
+        }
+
+        for (int i = 0; i < g_input_event_count; i++) RecordLatency(g_input_timestamp_ns, g_input_events[i].timestamp_ns);
+        PublishLatency(g_input_timestamp_ns);
+    }
+
+    void RuntimeSetFixedStepClock(const uint64_t step_timestamp_ns, const float interpolation_alpha)
+    {
+        g_fixed_step_timestamp_ns = step_timestamp_ns;
+        g_interpolation_alpha = interpolation_alpha;
+    }
+
+    uint64_t GetFixedStepTimestampNS()
+    {
+        return g_fixed_step_timestamp_ns;
+    }
+
+    float GetInterpolationAlpha()
+    {
+        return g_interpolation_alpha;
+    }
+
+    const InputLatencyStats& GetInputLatencyStats()
+    {
+        return g_latency_stats;
+    }
+
+    int GetInputEventCount()
+    {
+        return g_input_event_count;
+    }
+
+    const InputEvent& GetInputEvent(const int index)
+    {
+        // out of range is a caller bug; release builds get a key up of no key,
+        // which nothing reads as a press
+        static const InputEvent no_event{ InputEventType::KeyUp, KEY_COUNT, 0, -1, 0 };
+
+        assert(index >= 0 && index < g_input_event_count);
+        if (index < 0 || index >= g_input_event_count) return no_event;
+        return g_input_events[index];
+    }
+
+    uint64_t GetInputTimestampNS()
+    {
+        return g_input_timestamp_ns;
+    }
+
+    void SetFramePacing(FramePacingMode mode, const float target_rate_hz)
+    {
+        // headless frames follow the virtual clock, never the wall
+        if (g_options.headless) mode = FramePacingMode::Uncapped;
+
+        // present only blocks on the display in VSync mode
+        if (window) (void)SDL_SetRenderVSync(renderer, mode == FramePacingMode::VSync ? 1 : SDL_RENDERER_VSYNC_DISABLED);
+        g_pacer.Configure(mode, target_rate_hz);
+    }
+
+    FramePacingMode GetFramePacingMode()
+    {
+        return g_pacer.GetMode();
+    }
+
+    const FrameTimeStats& GetFrameTimeStats()
+    {
+        return g_pacer.GetStats();
+    }
+
+    uint64_t RuntimeWaitForFrame()
+    {
+        // in headless the pacer is uncapped and only measures wall time
+        const uint64_t wall_ns = g_pacer.WaitForNextFrame();
+        if (!g_options.headless) return wall_ns;
+
+        g_virtual_clock_ns += g_headless_frame_ns;
+        AudioPlayer::Get().AdvanceHeadless(static_cast<double>(g_headless_frame_ns) / 1000000000.0);
+        g_frames_run++;
+        return g_virtual_clock_ns;
     }
 
     void RuntimeBeginFrame()
     {
+        g_window_height = RuntimeGetWindowHeight();
+        g_frame_render_stats = RenderStats{};
+
+        if (!renderer) return;
         SetDrawColour(0.0f, 0.0f, 0.0f, 1.0f);
         (void)SDL_RenderClear(renderer);
     }
 
     void RuntimeEndFrame()
     {
+        FlushGeometry();
+        g_render_stats = g_frame_render_stats;
+        g_total_draw_calls += g_render_stats.draw_calls;
+
+        if (!renderer) return;
         SDL_RenderPresent(renderer);
     }
 
     float RuntimeGetWindowWidth()
     {
+        if (!window) return static_cast<float>(APP_VIRTUAL_WIDTH);
+
         int w = 0;
         int h = 0;
         SDL_GetWindowSize(window, &w, &h);
@@ -113,6 +710,8 @@ namespace Engine
 
     float RuntimeGetWindowHeight()
     {
+        if (!window) return static_cast<float>(APP_VIRTUAL_HEIGHT);
+
         int w = 0;
         int h = 0;
         SDL_GetWindowSize(window, &w, &h);
@@ -231,33 +830,6 @@ namespace Engine
         m_last_buttons = m_buttons;
     }
 
-    static uint32_t MapButtons(SDL_Gamepad* pad)
-    {
-        if (!pad) return 0;
-
-        uint32_t buttons = 0;
-
-        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_SOUTH)) buttons |= BTN_A;
-        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_EAST)) buttons |= BTN_B;
-        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_WEST)) buttons |= BTN_X;
-        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_NORTH)) buttons |= BTN_Y;
-
-        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_START)) buttons |= BTN_START;
-        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_BACK)) buttons |= BTN_BACK;
-
-        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_DPAD_LEFT)) buttons |= BTN_DPAD_LEFT;
-        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_DPAD_RIGHT)) buttons |= BTN_DPAD_RIGHT;
-        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_DPAD_UP)) buttons |= BTN_DPAD_UP;
-        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_DPAD_DOWN)) buttons |= BTN_DPAD_DOWN;
-
-        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_LEFT_SHOULDER)) buttons |= BTN_LBUMPER;
-        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER)) buttons |= BTN_RBUMPER;
-        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_LEFT_STICK)) buttons |= BTN_LSTICK;
-        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_RIGHT_STICK)) buttons |= BTN_RSTICK;
-
-        return buttons;
-    }
-
     void RuntimeTickInput()
     {
         for (int i = 0; i < key_count; i++)
@@ -272,44 +844,17 @@ namespace Engine
             current_key[i] = (scan != SDL_SCANCODE_UNKNOWN && keyboard[scan]) ? static_cast<uint8_t>(1) : static_cast<uint8_t>(0);
         }
 
-        SDL_UpdateGamepads();
-
+        // pad state comes from events, so taps shorter than a frame still register
         for (int i = 0; i < max_controllers; i++)
         {
-            g_controllers[i].AdvanceFrame();
-            g_controllers[i].SetConnected(false);
-            g_controllers[i].SetButtons(0);
-            g_controllers[i].SetAxes(0, 0, 0, 0, 0, 0);
-        }
+            const PadSlot& slot = g_pad_slots[i];
+            Controller& controller = g_controllers[i];
 
-        int count = 0;
-        SDL_JoystickID* pads = SDL_GetGamepads(&count);
-        if (!pads)
-        {
-            return;
+            controller.AdvanceFrame();
+            controller.SetButtons(slot.held | slot.tapped);
+            controller.SetConnected(slot.handle != nullptr);
+            controller.SetAxes(slot.axes[0], slot.axes[1], slot.axes[2], slot.axes[3], slot.axes[4], slot.axes[5]);
         }
-
-        count = std::min(count, max_controllers);
-        for (int i = 0; i < count; i++)
-        {
-            SDL_Gamepad* pad = SDL_OpenGamepad(pads[i]);
-            if (!pad) continue;
-
-            g_controllers[i].SetConnected(true);
-            g_controllers[i].SetButtons(MapButtons(pad));
-
-            const int16_t lx = SDL_GetGamepadAxis(pad, SDL_GAMEPAD_AXIS_LEFTX);
-            const int16_t ly = SDL_GetGamepadAxis(pad, SDL_GAMEPAD_AXIS_LEFTY);
-            const int16_t rx = SDL_GetGamepadAxis(pad, SDL_GAMEPAD_AXIS_RIGHTX);
-            const int16_t ry = SDL_GetGamepadAxis(pad, SDL_GAMEPAD_AXIS_RIGHTY);
-            const int16_t lt = SDL_GetGamepadAxis(pad, SDL_GAMEPAD_AXIS_LEFT_TRIGGER);
-            const int16_t rt = SDL_GetGamepadAxis(pad, SDL_GAMEPAD_AXIS_RIGHT_TRIGGER);
-            g_controllers[i].SetAxes(lx, ly, rx, ry, lt, rt);
-
-            SDL_CloseGamepad(pad);
-        }
-
-        SDL_free(pads);
     }
 
     const Controller& GetController(const int pad)
@@ -320,8 +865,29 @@ namespace Engine
 
     void DrawLine(const float sx, const float sy, const float ex, const float ey, const float r, const float g, const float b)
     {
-        SetDrawColour(r, g, b, 1.0f);
-        (void)SDL_RenderLine(renderer, ToRenderX(sx), ToRenderY(sy), ToRenderX(ex), ToRenderY(ey));
+        // one pixel wide quad, extended half a pixel past each end like a rasterized line
+        float dx = ex - sx;
+        float dy = ey - sy;
+        const float length = std::sqrt(dx * dx + dy * dy);
+        if (length > 0.0f)
+        {
+            dx = dx / length * 0.5f;
+            dy = dy / length * 0.5f;
+        }
+        else
+        {
+            dx = 0.5f;
+            dy = 0.0f;
+        }
+
+        const int base_vertex = BeginBatch(4, 6);
+        PushBatchVertex(sx - dx - dy, sy - dy + dx, r, g, b, 1.0f);
+        PushBatchVertex(sx - dx + dy, sy - dy - dx, r, g, b, 1.0f);
+        PushBatchVertex(ex + dx + dy, ey + dy - dx, r, g, b, 1.0f);
+        PushBatchVertex(ex + dx - dy, ey + dy + dx, r, g, b, 1.0f);
+
+        const int quad_indices[6] = { 0, 1, 2, 0, 2, 3 };
+        for (const int index : quad_indices) g_batch_indices.push_back(base_vertex + index);
     }
 
     void DrawTriangle(const float p1x, const float p1y, const float p1z, const float p1w,
@@ -347,40 +913,215 @@ namespace Engine
             return;
         }
 
-        SDL_Vertex verts[3];
-        verts[0].position.x = ToRenderX(p1x);
-        verts[0].position.y = ToRenderY(p1y);
-        verts[0].color.r = r1;
-        verts[0].color.g = g1;
-        verts[0].color.b = b1;
-        verts[0].color.a = 1.0f;
-        verts[0].tex_coord.x = 0.0f;
-        verts[0].tex_coord.y = 0.0f;
-
-        verts[1].position.x = ToRenderX(p2x);
-        verts[1].position.y = ToRenderY(p2y);
-        verts[1].color.r = r2;
-        verts[1].color.g = g2;
-        verts[1].color.b = b2;
-        verts[1].color.a = 1.0f;
-        verts[1].tex_coord.x = 0.0f;
-        verts[1].tex_coord.y = 0.0f;
-
-        verts[2].position.x = ToRenderX(p3x);
-        verts[2].position.y = ToRenderY(p3y);
-        verts[2].color.r = r3;
-        verts[2].color.g = g3;
-        verts[2].color.b = b3;
-        verts[2].color.a = 1.0f;
-        verts[2].tex_coord.x = 0.0f;
-        verts[2].tex_coord.y = 0.0f;
-
-        (void)SDL_RenderGeometry(renderer, nullptr, verts, 3, nullptr, 0);
+        const int base_vertex = BeginBatch(3, 3);
+        PushBatchVertex(p1x, p1y, r1, g1, b1, 1.0f);
+        PushBatchVertex(p2x, p2y, r2, g2, b2, 1.0f);
+        PushBatchVertex(p3x, p3y, r3, g3, b3, 1.0f);
+
+        g_batch_indices.push_back(base_vertex);
+        g_batch_indices.push_back(base_vertex + 1);
+        g_batch_indices.push_back(base_vertex + 2);
+    }
+
+    void DrawGeometry(const Vertex* vertices, const int vertex_count, const int* indices, const int index_count)
+    {
+        DrawGeometry(0, vertices, vertex_count, indices, index_count);
+    }
+
+    void DrawGeometry(const TextureId texture, const Vertex* vertices, const int vertex_count, const int* indices, const int index_count)
+    {
+        if (!vertices || vertex_count <= 0 || !indices || index_count <= 0) return;
+
+        // too big to ever share a batch, send it on its own
+        if (vertex_count > max_batch_vertices || index_count > max_batch_indices)
+        {
+            FlushGeometry();
+            g_batch_texture = texture;
+            for (int vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+            {
+                const Vertex& vertex = vertices[vertex_index];
+                PushBatchVertex(vertex.x, vertex.y, vertex.r, vertex.g, vertex.b, vertex.a, vertex.u, vertex.v);
+            }
+            g_batch_indices.assign(indices, indices + index_count);
+            FlushGeometry();
+            return;
+        }
+
+        const int base_vertex = BeginBatch(vertex_count, index_count, texture);
+        for (int vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+        {
+            const Vertex& vertex = vertices[vertex_index];
+            PushBatchVertex(vertex.x, vertex.y, vertex.r, vertex.g, vertex.b, vertex.a, vertex.u, vertex.v);
+        }
+        for (int index = 0; index < index_count; ++index)
+        {
+            g_batch_indices.push_back(base_vertex + indices[index]);
+        }
+    }
+
+    void FlushGeometry()
+    {
+        if (g_batch_indices.empty())
+        {
+            g_batch_vertices.clear();
+            return;
+        }
+
+        // the counting sink keeps the stats without drawing
+        if (renderer)
+        {
+            const TextureSlot* slot = FindTexture(g_batch_texture);
+            (void)SDL_RenderGeometry(renderer, slot ? slot->texture : nullptr,
+                                     g_batch_vertices.data(), static_cast<int>(g_batch_vertices.size()),
+                                     g_batch_indices.data(), static_cast<int>(g_batch_indices.size()));
+        }
+
+        g_frame_render_stats.draw_calls++;
+        g_frame_render_stats.geometry_flushes++;
+        g_frame_render_stats.vertices += static_cast<uint32_t>(g_batch_vertices.size());
+        g_frame_render_stats.triangles += static_cast<uint32_t>(g_batch_indices.size() / 3);
+
+        g_batch_vertices.clear();
+        g_batch_indices.clear();
+    }
+
+    const RenderStats& GetRenderStats()
+    {
+        return g_render_stats;
+    }
+
+    static TextureSlot* FindTexture(const TextureId texture)
+    {
+        if (texture == 0 || texture > g_textures.size()) return nullptr;
+
+        TextureSlot& slot = g_textures[texture - 1];
+        return slot.in_use ? &slot : nullptr;
+    }
+
+    static TextureId AddTexture(const int width, const int height, const SDL_TextureAccess access,
+                                const SDL_BlendMode blend_mode, const SDL_ScaleMode scale_mode)
+    {
+        if (width <= 0 || height <= 0) return 0;
+
+        size_t slot_index = 0;
+        while (slot_index < g_textures.size() && g_textures[slot_index].in_use) ++slot_index;
+        if (slot_index == g_textures.size()) g_textures.emplace_back();
+
+        TextureSlot& slot = g_textures[slot_index];
+        slot = TextureSlot{};
+        slot.width = width;
+        slot.height = height;
+        slot.in_use = true;
+
+        if (renderer)
+        {
+            slot.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, access, width, height);
+            if (!slot.texture)
+            {
+                slot = TextureSlot{};
+                return 0;
+            }
+            (void)SDL_SetTextureBlendMode(slot.texture, blend_mode);
+            (void)SDL_SetTextureScaleMode(slot.texture, scale_mode);
+        }
+
+        return static_cast<TextureId>(slot_index + 1);
+    }
+
+    TextureId CreateTexture(const int width, const int height, const bool smooth)
+    {
+        return AddTexture(width, height, SDL_TEXTUREACCESS_STATIC, SDL_BLENDMODE_BLEND,
+                          smooth ? SDL_SCALEMODE_LINEAR : SDL_SCALEMODE_NEAREST);
+    }
+
+    TextureId CreateRenderTexture(const int width, const int height)
+    {
+        // blended draws leave premultiplied colour in the target
+        return AddTexture(width, height, SDL_TEXTUREACCESS_TARGET, SDL_BLENDMODE_BLEND_PREMULTIPLIED, SDL_SCALEMODE_LINEAR);
+    }
+
+    void BeginRenderToTexture(const TextureId texture)
+    {
+        const TextureSlot* slot = FindTexture(texture);
+        if (!slot || g_render_target != 0) return;
+
+        FlushGeometry();
+        g_render_target = texture;
+
+        // y flips against the target, not the window
+        g_screen_height = g_window_height;
+        g_window_height = static_cast<float>(slot->height);
+
+        if (!slot->texture) return;
+        (void)SDL_SetRenderTarget(renderer, slot->texture);
+        SetDrawColour(0.0f, 0.0f, 0.0f, 0.0f);
+        (void)SDL_RenderClear(renderer);
+    }
+
+    void EndRenderToTexture()
+    {
+        if (g_render_target == 0) return;
+
+        FlushGeometry();
+        g_render_target = 0;
+        g_window_height = g_screen_height;
+
+        if (!renderer) return;
+        (void)SDL_SetRenderTarget(renderer, nullptr);
+    }
+
+    uint32_t GetRenderTargetGeneration()
+    {
+        return g_render_target_generation;
+    }
+
+    void UpdateTexture(const TextureId texture, const uint8_t* rgba_pixels)
+    {
+        const TextureSlot* slot = FindTexture(texture);
+        if (!slot || !slot->texture || !rgba_pixels) return;
+
+        (void)SDL_UpdateTexture(slot->texture, nullptr, rgba_pixels, slot->width * 4);
+    }
+
+    void DestroyTexture(const TextureId texture)
+    {
+        TextureSlot* slot = FindTexture(texture);
+        if (!slot) return;
+
+        // don't leave a pending batch pointing at it, or the renderer drawing into it
+        if (g_render_target == texture) EndRenderToTexture();
+        if (g_batch_texture == texture) FlushGeometry();
+        if (slot->texture) SDL_DestroyTexture(slot->texture);
+        *slot = TextureSlot{};
+    }
+
+    void DrawTexture(const TextureId texture,
+                     const float src_x, const float src_y, const float src_width, const float src_height,
+                     const float dest_x, const float dest_y, const float dest_width, const float dest_height)
+    {
+        const TextureSlot* slot = FindTexture(texture);
+        if (!slot || texture == g_render_target || src_width <= 0.0f || src_height <= 0.0f) return;
+
+        // keep it ordered after the geometry batched before it
+        FlushGeometry();
+        g_frame_render_stats.draw_calls++;
+
+        if (!slot->texture) return;
+
+        const SDL_FRect src_rect = { src_x, src_y, src_width, src_height };
+        const SDL_FRect dest_rect = { ToRenderX(dest_x), ToRenderY(dest_y + dest_height), dest_width, dest_height };
+        (void)SDL_RenderTexture(renderer, slot->texture, &src_rect, &dest_rect);
     }
 
     void Print(const float x, const float y, const char* text, const float r, const float g, const float b, void* font)
     {
         (void)font;
+
+        // text goes through its own path, so keep it ordered after what came before
+        FlushGeometry();
+        g_frame_render_stats.draw_calls++;
+
+        if (!renderer) return;
         SetDrawColour(r, g, b, 1.0f);
         (void)SDL_RenderDebugText(renderer, ToRenderX(x), ToRenderY(y), text);
     }
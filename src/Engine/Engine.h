@@ -3,6 +3,7 @@
 #include "EngineSettings.h"
 #include "Input.h"
 #include "Controller.h"
+#include "FramePacer.h"
 
 #include <cstdint>
 
@@ -20,6 +21,67 @@ namespace Engine
 
     void Print(float x, float y, const char* text, float r = 1.0f, float g = 1.0f, float b = 1.0f, void* font = nullptr);
 
+    // batched geometry in virtual coordinates (y up); indices are relative
+    // to the vertices passed in the same call
+    struct Vertex
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float r = 1.0f;
+        float g = 1.0f;
+        float b = 1.0f;
+        float a = 1.0f;
+
+        // 0..1 across the texture, top left origin; unused when untextured
+        float u = 0.0f;
+        float v = 0.0f;
+    };
+
+    void DrawGeometry(const Vertex* vertices, int vertex_count, const int* indices, int index_count);
+
+    // submits whatever is batched; called for you before text and at frame end
+    void FlushGeometry();
+
+    // draw submissions made during the previous frame
+    struct RenderStats
+    {
+        uint32_t draw_calls = 0;
+        uint32_t geometry_flushes = 0;
+        uint32_t vertices = 0;
+        uint32_t triangles = 0;
+    };
+
+    const RenderStats& GetRenderStats();
+
+    // offscreen images drawn as quads; pixels are RGBA bytes, rows top to
+    // bottom. ids are handed out headless too, and 0 is never valid
+    using TextureId = uint32_t;
+
+    // smooth filters when scaled; otherwise nearest texel
+    TextureId CreateTexture(int width, int height, bool smooth = false);
+    void UpdateTexture(TextureId texture, const uint8_t* rgba_pixels);
+    void DestroyTexture(TextureId texture);
+
+    // vertex colours modulate the texture; joins the batch while the texture stays the same
+    void DrawGeometry(TextureId texture, const Vertex* vertices, int vertex_count, const int* indices, int index_count);
+
+    // src in texture pixels from the top left, dest in virtual coordinates from the bottom left
+    void DrawTexture(TextureId texture,
+                     float src_x, float src_y, float src_width, float src_height,
+                     float dest_x, float dest_y, float dest_width, float dest_height);
+
+    // textures drawn into instead of uploaded. between Begin and End every
+    // draw lands in the texture, cleared to transparent, with the same y up
+    // coordinates as the screen. contents are premultiplied and composite
+    // over whatever is below when drawn
+    TextureId CreateRenderTexture(int width, int height);
+    void BeginRenderToTexture(TextureId texture);
+    void EndRenderToTexture();
+
+    // bumped when the device drops render texture contents; anything kept
+    // in one should be redrawn when this changes
+    uint32_t GetRenderTargetGeneration();
+
     void PlayAudio(const char* file_name, bool is_looping = false);
     void StopAudio(const char* file_name);
     bool IsSoundPlaying(const char* file_name);
@@ -39,12 +101,72 @@ namespace Engine
 
     const Controller& GetController(int pad = 0);
 
-    bool RuntimeInit();
+    // key and button edges pumped this frame, in arrival order;
+    // index must be below GetInputEventCount()
+    int GetInputEventCount();
+    const InputEvent& GetInputEvent(int index);
+    uint64_t GetInputTimestampNS();
+
+    // time from an edge being seen to the frame that judges it, over the last second
+    struct InputLatencyStats
+    {
+        float mean_ms = 0.0f;
+        float max_ms = 0.0f;
+        float poll_rate_hz = 0.0f;
+        uint32_t samples = 0;
+        uint32_t dropped = 0;
+    };
+
+    const InputLatencyStats& GetInputLatencyStats();
+
+    // frame pacing; target_rate_hz only applies to Fixed
+    void SetFramePacing(FramePacingMode mode, float target_rate_hz = APP_MAX_FRAME_RATE);
+    FramePacingMode GetFramePacingMode();
+    const FrameTimeStats& GetFrameTimeStats();
+
+    // fixed-step clock: wall time of the last simulated step, and how far
+    // the frame has moved past it as a fraction of one step
+    uint64_t GetFixedStepTimestampNS();
+    float GetInterpolationAlpha();
+
+    // headless runs render into a counting sink or an offscreen software
+    // surface, mix audio without a device, and run on a virtual clock
+    enum class HeadlessRender
+    {
+        Count,
+        Software
+    };
+
+    struct RuntimeOptions
+    {
+        bool headless = APP_HEADLESS_DEFAULT;
+        HeadlessRender headless_render = HeadlessRender::Count;
+        float headless_frame_rate = APP_HEADLESS_FRAME_RATE;
+        uint64_t max_frames = 0; // 0 runs until quit
+    };
+
+    const RuntimeOptions& GetRuntimeOptions();
+    bool IsHeadless();
+
+    // "--flag", "--flag value" and "--flag=value" forms
+    bool HasCommandLineFlag(const char* flag);
+    const char* GetCommandLineValue(const char* flag);
+
+    void RequestQuit();
+
+    // returned from main once the loop ends; 0 unless a run sets it
+    void SetExitCode(int exit_code);
+    int GetExitCode();
+
+    bool RuntimeInit(int argc, char** argv);
     void RuntimeShutdown();
     void RuntimePumpEvents(bool& quit);
+    uint64_t RuntimeGetTicksNS();
+    uint64_t RuntimeWaitForFrame();
     void RuntimeBeginFrame();
     void RuntimeEndFrame();
     void RuntimeTickInput();
+    void RuntimeSetFixedStepClock(uint64_t step_timestamp_ns, float interpolation_alpha);
     float RuntimeGetWindowWidth();
     float RuntimeGetWindowHeight();
 }
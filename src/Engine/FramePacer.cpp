@@ -0,0 +1,99 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <SDL3/SDL.h>
+
+namespace Engine
+{
+    void FramePacer::Configure(const FramePacingMode mode, const float target_rate_hz)
+    {
+        m_mode = mode;
+        if (target_rate_hz > 0.0f) m_period_ns = static_cast<uint64_t>(1000000000.0 / static_cast<double>(target_rate_hz));
+
+        // restart the schedule from the next frame
+        m_next_deadline_ns = 0;
+    }
+
+    void FramePacer::SetInputPoll(const PollFn poll, const float poll_rate_hz)
+    {
+        m_poll = poll;
+        if (poll_rate_hz > 0.0f) m_poll_period_ns = static_cast<uint64_t>(1000000000.0 / static_cast<double>(poll_rate_hz));
+    }
+
+    uint64_t FramePacer::WaitForNextFrame()
+    {
+        uint64_t now_ns = SDL_GetTicksNS();
+
+        if (m_mode == FramePacingMode::Fixed)
+        {
+            if (m_next_deadline_ns == 0) m_next_deadline_ns = now_ns;
+
+            // coarse sleep, leaving the last stretch for the spin; with an
+            // input poll it sleeps one poll period at a time
+            while (m_next_deadline_ns > now_ns + spin_window_ns)
+            {
+                uint64_t sleep_ns = m_next_deadline_ns - now_ns - spin_window_ns;
+                if (m_poll)
+                {
+                    m_poll();
+                    sleep_ns = std::min(sleep_ns, m_poll_period_ns);
+                }
+                SDL_DelayNS(sleep_ns);
+                now_ns = SDL_GetTicksNS();
+            }
+
+            // spin out the remainder
+            now_ns = SDL_GetTicksNS();
+            while (now_ns < m_next_deadline_ns) now_ns = SDL_GetTicksNS();
+
+            // schedule from the deadline so the error doesn't accumulate,
+            // but don't burst frames after a stall
+            m_next_deadline_ns += m_period_ns;
+            if (m_next_deadline_ns + m_period_ns < now_ns) m_next_deadline_ns = now_ns + m_period_ns;
+        }
+
+        RecordFrame(now_ns);
+        return now_ns;
+    }
+
+    void FramePacer::RecordFrame(const uint64_t frame_start_ns)
+    {
+        if (m_last_frame_ns != 0)
+        {
+            const double frame_ms = static_cast<double>(frame_start_ns - m_last_frame_ns) / 1000000.0;
+            m_history_ms[m_history_next] = static_cast<float>(frame_ms);
+            m_history_next = (m_history_next + 1) % history_size;
+            m_history_count = std::min(m_history_count + 1, history_size);
+
+            if (++m_frames_since_stats >= stats_interval_frames)
+            {
+                m_frames_since_stats = 0;
+                RefreshStats();
+            }
+        }
+
+        m_last_frame_ns = frame_start_ns;
+    }
+
+    void FramePacer::RefreshStats()
+    {
+        if (m_history_count == 0) return;
+
+        double total_ms = 0.0;
+        float max_ms = 0.0f;
+        for (int i = 0; i < m_history_count; i++)
+        {
+            total_ms += m_history_ms[i];
+            max_ms = std::max(max_ms, m_history_ms[i]);
+            m_scratch_ms[i] = m_history_ms[i];
+        }
+
+        // partial sort is enough for one percentile
+        const int p99_index = std::min(m_history_count - 1, (m_history_count * 99) / 100);
+        std::nth_element(m_scratch_ms, m_scratch_ms + p99_index, m_scratch_ms + m_history_count);
+
+        m_stats.mean_ms = static_cast<float>(total_ms / m_history_count);
+        m_stats.p99_ms = m_scratch_ms[p99_index];
+        m_stats.max_ms = max_ms;
+        m_stats.samples = static_cast<uint32_t>(m_history_count);
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Engine
+{
+    enum class FramePacingMode
+    {
+        VSync,
+        Fixed,
+        Uncapped
+    };
+
+    // frame-to-frame time over the most recent window
+    struct FrameTimeStats
+    {
+        float mean_ms = 0.0f;
+        float p99_ms = 0.0f;
+        float max_ms = 0.0f;
+        uint32_t samples = 0;
+    };
+
+    /////////////////
+    // Frame Pacer //
+    /////////////////////////////////////////////////////////////
+    // Fixed mode sleeps until just before the deadline, then  //
+    // spins the last stretch, since OS sleeps only land to    //
+    // about a millisecond. VSync and Uncapped don't wait: the //
+    // first blocks in present, the second runs flat out. An   //
+    // input poll, if set, runs between sleep slices so input  //
+    // is sampled while the frame waits.                       //
+    /////////////////////////////////////////////////////////////
+    class FramePacer
+    {
+    public:
+        static constexpr int history_size = 240;
+        static constexpr int stats_interval_frames = 30;
+        static constexpr uint64_t spin_window_ns = 1000000;
+
+        using PollFn = void (*)();
+
+        void Configure(FramePacingMode mode, float target_rate_hz);
+        FramePacingMode GetMode() const { return m_mode; }
+
+        // called from WaitForNextFrame on the waiting thread; nullptr to stop
+        void SetInputPoll(PollFn poll, float poll_rate_hz);
+
+        // blocks until the next frame is due and returns its start time
+        uint64_t WaitForNextFrame();
+
+        const FrameTimeStats& GetStats() const { return m_stats; }
+
+    private:
+        void RecordFrame(uint64_t frame_start_ns);
+        void RefreshStats();
+
+    private:
+        FramePacingMode m_mode = FramePacingMode::Fixed;
+        uint64_t m_period_ns = 16666667;
+        uint64_t m_next_deadline_ns = 0;
+        uint64_t m_last_frame_ns = 0;
+
+        PollFn m_poll = nullptr;
+        uint64_t m_poll_period_ns = 1000000;
+
+        float m_history_ms[history_size] = {};
+        float m_scratch_ms[history_size] = {};
+        int m_history_next = 0;
+        int m_history_count = 0;
+        int m_frames_since_stats = 0;
+
+        FrameTimeStats m_stats;
+    };
+}
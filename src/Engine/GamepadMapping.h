@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <SDL3/SDL.h>
+#include "Input.h"
+
+namespace Engine
+{
+    // SDL gamepad buttons to the engine's button bits
+    inline uint32_t ButtonForSdl(const uint8_t button)
+    {
+        switch (button)
+        {
+            case SDL_GAMEPAD_BUTTON_SOUTH: return BTN_A;
+            case SDL_GAMEPAD_BUTTON_EAST: return BTN_B;
+            case SDL_GAMEPAD_BUTTON_WEST: return BTN_X;
+            case SDL_GAMEPAD_BUTTON_NORTH: return BTN_Y;
+            case SDL_GAMEPAD_BUTTON_START: return BTN_START;
+            case SDL_GAMEPAD_BUTTON_BACK: return BTN_BACK;
+            case SDL_GAMEPAD_BUTTON_DPAD_LEFT: return BTN_DPAD_LEFT;
+            case SDL_GAMEPAD_BUTTON_DPAD_RIGHT: return BTN_DPAD_RIGHT;
+            case SDL_GAMEPAD_BUTTON_DPAD_UP: return BTN_DPAD_UP;
+            case SDL_GAMEPAD_BUTTON_DPAD_DOWN: return BTN_DPAD_DOWN;
+            case SDL_GAMEPAD_BUTTON_LEFT_SHOULDER: return BTN_LBUMPER;
+            case SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER: return BTN_RBUMPER;
+            case SDL_GAMEPAD_BUTTON_LEFT_STICK: return BTN_LSTICK;
+            case SDL_GAMEPAD_BUTTON_RIGHT_STICK: return BTN_RSTICK;
+            default: return 0;
+        }
+    }
+
+    inline uint32_t MapButtons(SDL_Gamepad* pad)
+    {
+        if (!pad) return 0;
+
+        uint32_t buttons = 0;
+
+        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_SOUTH)) buttons |= BTN_A;
+        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_EAST)) buttons |= BTN_B;
+        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_WEST)) buttons |= BTN_X;
+        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_NORTH)) buttons |= BTN_Y;
+
+        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_START)) buttons |= BTN_START;
+        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_BACK)) buttons |= BTN_BACK;
+
+        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_DPAD_LEFT)) buttons |= BTN_DPAD_LEFT;
+        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_DPAD_RIGHT)) buttons |= BTN_DPAD_RIGHT;
+        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_DPAD_UP)) buttons |= BTN_DPAD_UP;
+        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_DPAD_DOWN)) buttons |= BTN_DPAD_DOWN;
+
+        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_LEFT_SHOULDER)) buttons |= BTN_LBUMPER;
+        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER)) buttons |= BTN_RBUMPER;
+        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_LEFT_STICK)) buttons |= BTN_LSTICK;
+        if (SDL_GetGamepadButton(pad, SDL_GAMEPAD_BUTTON_RIGHT_STICK)) buttons |= BTN_RSTICK;
+
+        return buttons;
+    }
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace Engine
 {
     enum Key
@@ -77,4 +79,22 @@ namespace Engine
         BTN_DPAD_UP = 0x1000,
         BTN_DPAD_DOWN = 0x2000,
     };
+
+    enum class InputEventType
+    {
+        KeyDown,
+        KeyUp,
+        ButtonDown,
+        ButtonUp,
+    };
+
+    // a single key or button edge, stamped with the time the OS saw it
+    struct InputEvent
+    {
+        InputEventType type = InputEventType::KeyDown;
+        Key key = KEY_COUNT;
+        uint32_t button = 0;
+        int pad = 0;
+        uint64_t timestamp_ns = 0;
+    };
 }
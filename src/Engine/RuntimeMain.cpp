@@ -1,18 +1,18 @@
 #include "Engine.h"
+#include "Util/AllocTracker.h"
+#include "Util/Profiler.h"
 
 #include <SDL3/SDL.h>
 
 extern void Init();
 extern void Update(float delta_time_ms);
+extern void FixedUpdate(float step_time_ms);
 extern void Render();
 extern void Shutdown();
 
 int main(int argc, char** argv)
 {
-    (void)argc;
-    (void)argv;
-
-    if (!Engine::RuntimeInit())
+    if (!Engine::RuntimeInit(argc, argv))
     {
         return 1;
     }
@@ -20,34 +20,65 @@ int main(int argc, char** argv)
     Init();
 
     bool quit = false;
-    uint64_t last_ticks = SDL_GetTicksNS();
-    const uint64_t target_frame_ns = static_cast<uint64_t>((1.0 / static_cast<double>(APP_MAX_FRAME_RATE)) * 1000.0 * 1000.0 * 1000.0);
+    const uint64_t max_frames = Engine::GetRuntimeOptions().max_frames;
+    uint64_t frame_index = 0;
+    uint64_t last_ticks = Engine::RuntimeGetTicksNS();
+    // fixed-step simulation clock trails wall time by less than one step
+    const uint64_t fixed_step_ns = static_cast<uint64_t>((1.0 / static_cast<double>(APP_FIXED_STEP_RATE)) * 1000.0 * 1000.0 * 1000.0);
+    const float fixed_step_ms = static_cast<float>(static_cast<double>(fixed_step_ns) / 1000000.0);
+    const uint64_t max_catch_up_ns = fixed_step_ns * static_cast<uint64_t>(APP_MAX_FIXED_STEPS_PER_FRAME);
+    uint64_t fixed_clock_ns = last_ticks;
+    Engine::RuntimeSetFixedStepClock(fixed_clock_ns, 0.0f);
 
     while (!quit)
     {
-        const uint64_t now_ticks = SDL_GetTicksNS();
+        // the pacer sleeps/spins to the next frame (or not at all, per mode)
+        const uint64_t now_ticks = Engine::RuntimeWaitForFrame();
         const uint64_t delta_ns = now_ticks - last_ticks;
         const float delta_ms = static_cast<float>(static_cast<double>(delta_ns) / 1000000.0);
 
-        if (delta_ns < target_frame_ns)
+        last_ticks = now_ticks;
+
         {
-            SDL_DelayNS(target_frame_ns - delta_ns);
-            continue;
+            PROFILE_ZONE("RuntimePumpEvents");
+            Engine::RuntimePumpEvents(quit);
+            Engine::RuntimeTickInput();
         }
 
-        last_ticks = now_ticks;
+        Update(delta_ms);
 
-        Engine::RuntimePumpEvents(quit);
-        Engine::RuntimeTickInput();
+        // after a long stall, drop the time we can't catch up on
+        if (now_ticks - fixed_clock_ns > max_catch_up_ns) fixed_clock_ns = now_ticks - max_catch_up_ns;
 
-        Update(delta_ms);
+        {
+            PROFILE_ZONE("FixedSteps");
+            while (now_ticks - fixed_clock_ns >= fixed_step_ns)
+            {
+                fixed_clock_ns += fixed_step_ns;
+                Engine::RuntimeSetFixedStepClock(fixed_clock_ns, 0.0f);
+                FixedUpdate(fixed_step_ms);
+            }
+        }
+
+        const float alpha = static_cast<float>(static_cast<double>(now_ticks - fixed_clock_ns) / static_cast<double>(fixed_step_ns));
+        Engine::RuntimeSetFixedStepClock(fixed_clock_ns, alpha);
 
         Engine::RuntimeBeginFrame();
         Render();
-        Engine::RuntimeEndFrame();
+
+        {
+            PROFILE_ZONE("RuntimeEndFrame");
+            Engine::RuntimeEndFrame();
+        }
+
+        // gathers this frame's zones from every thread, and the main thread's allocations
+        Rhythm::Profiler::EndFrame();
+        Rhythm::AllocTracker::EndFrame();
+
+        if (max_frames > 0 && ++frame_index >= max_frames) quit = true;
     }
 
     Shutdown();
     Engine::RuntimeShutdown();
-    return 0;
+    return Engine::GetExitCode();
 }
@@ -2,6 +2,11 @@
 #include "Engine/Engine.h"
 #include "UI/Core/GameUI.h"
 #include "Math/MathUtils.h"
+#include "Util/Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace
 {
@@ -15,11 +20,40 @@ namespace
     constexpr float debug_panel_text_x_offset = 8.0f;
     constexpr float debug_line_height = 14.0f;
     constexpr float debug_line_spacing = 2.0f;
+
+    // pages are a couple of bars wide, and the next one is rasterized before it scrolls in
+    constexpr int page_bars = 2;
+    constexpr int prefetch_pages = 1;
+
+    // beyond what a frame can touch, so a finished page has somewhere to land
+    constexpr int spare_page_slots = 1;
     
     float CalculateDrumVisualDuration(const int beats_per_bar)
     {
         return (static_cast<float>(beats_per_bar) / 4.0f) * drum_visual_note_duration;
     }
+
+    // the beat a note's rectangle ends on, before clipping to the view
+    float CalculateVisualEndBeat(const NoteEvent& note, const int beats_per_bar)
+    {
+        return IsDrumVoice(note.voice)
+            ? note.start_beat + CalculateDrumVisualDuration(beats_per_bar)
+            : note.start_beat + MaxFloat(0.001f, note.duration_beat);
+    }
+
+    // [first, last) of the index entries that can overlap [start_beat, end_beat]
+    void FindOverlappingNotes(const std::vector<float>& start_beats, const std::vector<float>& max_end_beats,
+                              const float start_beat, const float end_beat, size_t& first, size_t& last)
+    {
+        // first entry whose running max end reaches the range, through the last one starting inside it
+        first = static_cast<size_t>(std::lower_bound(max_end_beats.begin(), max_end_beats.end(), start_beat) - max_end_beats.begin());
+        last = static_cast<size_t>(std::upper_bound(start_beats.begin(), start_beats.end(), end_beat) - start_beats.begin());
+    }
+
+    uint8_t ToColourByte(const float value)
+    {
+        return static_cast<uint8_t>(ClampFloat(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
 }
 
 PianoRollRenderer::ThemeColours::RGB 
@@ -36,7 +70,7 @@ PianoRollRenderer::ThemeColours::GetVoiceColour(const VoiceType voice)
     }
 }
 
-PianoRollRenderer::RenderLayout PianoRollRenderer::CalculateLayout(const Config& config) const
+PianoRollRenderer::RenderLayout PianoRollRenderer::CalculateLayout(const Config& config)
 {
     RenderLayout layout;
     
@@ -66,10 +100,45 @@ PianoRollRenderer::RenderLayout PianoRollRenderer::CalculateLayout(const Config&
     return layout;
 }
 
+void PianoRollRenderer::DrawRollLine(PageImage* page, const float start_x, const float start_y,
+                                     const float end_x, const float end_y, const ThemeColours::RGB& colour)
+{
+    if (!page)
+    {
+        Engine::DrawLine(start_x, start_y, end_x, end_y, colour.red, colour.green, colour.blue);
+        return;
+    }
+
+    // one pixel per step along the longer axis, like the frame's one pixel wide line
+    const float pixel_start_x = start_x;
+    const float pixel_start_y = page->top_y - start_y;
+    const float delta_x = end_x - start_x;
+    const float delta_y = start_y - end_y;
+    const int steps = static_cast<int>(std::ceil(MaxFloat(std::fabs(delta_x), std::fabs(delta_y))));
+
+    const uint8_t red = ToColourByte(colour.red);
+    const uint8_t green = ToColourByte(colour.green);
+    const uint8_t blue = ToColourByte(colour.blue);
+
+    for (int step = 0; step <= steps; ++step)
+    {
+        const float fraction = steps > 0 ? static_cast<float>(step) / static_cast<float>(steps) : 0.0f;
+        const int pixel_x = static_cast<int>(std::floor(pixel_start_x + delta_x * fraction));
+        const int pixel_y = static_cast<int>(std::floor(pixel_start_y + delta_y * fraction));
+        if (pixel_x < 0 || pixel_x >= page->width || pixel_y < 0 || pixel_y >= page->height) continue;
+
+        uint8_t* pixel = &page->pixels[(static_cast<size_t>(pixel_y) * static_cast<size_t>(page->width) + static_cast<size_t>(pixel_x)) * 4];
+        pixel[0] = red;
+        pixel[1] = green;
+        pixel[2] = blue;
+        pixel[3] = 255;
+    }
+}
+
 void PianoRollRenderer::DrawVerticalGridLines(
     const float region_left_x, const float region_top_y, const float region_height,
     const float view_start_beat, const float view_end_beat, const float pixels_per_beat, const int beats_per_bar,
-    const ThemeColours::RGB& beat_colour, const ThemeColours::RGB& bar_colour)
+    const ThemeColours::RGB& beat_colour, const ThemeColours::RGB& bar_colour, PageImage* page)
 {
     const int start_beat_index = static_cast<int>(std::floor(view_start_beat));
     const int end_beat_index = static_cast<int>(std::ceil(view_end_beat));
@@ -80,14 +149,13 @@ void PianoRollRenderer::DrawVerticalGridLines(
         const bool is_bar_line = (beats_per_bar > 0) && (beat_index % beats_per_bar == 0);
         const auto& colour = is_bar_line ? bar_colour : beat_colour;
         
-        Engine::DrawLine(beat_x, region_top_y, beat_x, region_top_y + region_height, 
-                     colour.red, colour.green, colour.blue);
+        DrawRollLine(page, beat_x, region_top_y, beat_x, region_top_y + region_height, colour);
     }
 }
 
 void PianoRollRenderer::DrawHorizontalGridLines(
     const float region_left_x, const float region_top_y, const float region_width, const float region_height,
-    const int num_divisions, const ThemeColours::RGB& colour)
+    const int num_divisions, const ThemeColours::RGB& colour, PageImage* page)
 {
     if (num_divisions <= 0) return;
     
@@ -96,8 +164,7 @@ void PianoRollRenderer::DrawHorizontalGridLines(
     for (int lane_index = 0; lane_index <= num_divisions; ++lane_index)
     {
         const float line_y = region_top_y + static_cast<float>(lane_index) * lane_height;
-        Engine::DrawLine(region_left_x, line_y, region_left_x + region_width, line_y, 
-                     colour.red, colour.green, colour.blue);
+        DrawRollLine(page, region_left_x, line_y, region_left_x + region_width, line_y, colour);
     }
 }
 
@@ -165,15 +232,13 @@ PianoRollRenderer::CalculateNoteColour(const VoiceType voice, const float veloci
 
 PianoRollRenderer::NoteRenderInfo 
 PianoRollRenderer::CalculateNoteRenderInfo(const NoteEvent& note, const RenderLayout& layout, 
-                                           const Config& config) const
+                                           const Config& config)
 {
     NoteRenderInfo info;
     
     // calculate visible beat range
     float start_beat = note.start_beat;
-    float end_beat = IsDrumVoice(note.voice) 
-        ? start_beat + CalculateDrumVisualDuration(config.beats_per_bar)
-        : start_beat + MaxFloat(0.001f, note.duration_beat);
+    float end_beat = CalculateVisualEndBeat(note, config.beats_per_bar);
     
     if (config.clamp_to_view)
     {
@@ -203,14 +268,21 @@ PianoRollRenderer::CalculateNoteRenderInfo(const NoteEvent& note, const RenderLa
     return info;
 }
 
-void PianoRollRenderer::DrawNote(const NoteRenderInfo& info)
+void PianoRollRenderer::DrawNote(const NoteRenderInfo& info, PageImage* page)
 {
     if (!info.is_valid) return;
     
-    const GameUI::Colour colour = { info.note_colour.red, info.note_colour.green, info.note_colour.blue };
+    // outline plus diagonal, the same lines as GameUI::DrawRectangle's wireframe
+    const float left_x = info.position.position_x;
+    const float bottom_y = info.position.position_y;
+    const float right_x = left_x + info.position.width;
+    const float top_y = bottom_y + info.position.height;
 
-    GameUI::DrawRectangle(info.position.position_x, info.position.position_y, 
-                          info.position.width, info.position.height, colour, true);
+    DrawRollLine(page, left_x, bottom_y, right_x, bottom_y, info.note_colour);
+    DrawRollLine(page, right_x, bottom_y, right_x, top_y, info.note_colour);
+    DrawRollLine(page, right_x, top_y, left_x, top_y, info.note_colour);
+    DrawRollLine(page, left_x, top_y, left_x, bottom_y, info.note_colour);
+    DrawRollLine(page, left_x, bottom_y, right_x, top_y, info.note_colour);
 }
 
 void PianoRollRenderer::DrawDebugPanel(const float panel_top_y, const float panel_height,
@@ -255,41 +327,406 @@ void PianoRollRenderer::DrawPlayhead(const RenderLayout& layout, const Config& c
                  ThemeColours::PLAYHEAD.red, ThemeColours::PLAYHEAD.green, ThemeColours::PLAYHEAD.blue);
 }
 
-void PianoRollRenderer::DrawGrids(const RenderLayout& layout, const Config& config)
+void PianoRollRenderer::DrawGrids(const RenderLayout& layout, const Config& config, PageImage* page)
 {
     // drum track grid
     DrawHorizontalGridLines(config.origin_x, layout.drum_top_y, config.width, layout.drum_height, 
-                           3, ThemeColours::GRID_DRUM_LANE);
+                           3, ThemeColours::GRID_DRUM_LANE, page);
     
     DrawVerticalGridLines(config.origin_x, layout.drum_top_y, layout.drum_height, layout.view_start_beat,
                           layout.view_end_beat, layout.pixels_per_beat, config.beats_per_bar,
-                          ThemeColours::GRID_BEAT, ThemeColours::GRID_DRUM_BAR);
+                          ThemeColours::GRID_BEAT, ThemeColours::GRID_DRUM_BAR, page);
     
     // pitch lanes grid
     if (layout.pitch_height > 0.0f)
     {
         DrawHorizontalGridLines(config.origin_x, layout.pitch_top_y, config.width, layout.pitch_height,
-                               layout.pitch_lane_count, ThemeColours::GRID_PITCH_LANE);
+                               layout.pitch_lane_count, ThemeColours::GRID_PITCH_LANE, page);
         DrawVerticalGridLines(config.origin_x, layout.pitch_top_y, layout.pitch_height, layout.view_start_beat,
                               layout.view_end_beat, layout.pixels_per_beat, config.beats_per_bar,
-                              ThemeColours::GRID_BEAT, ThemeColours::GRID_BAR);
+                              ThemeColours::GRID_BEAT, ThemeColours::GRID_BAR, page);
     }
 }
 
-void PianoRollRenderer::Draw(const EventSequence& sequence, const Config& config) const
+void PianoRollRenderer::EnsureIndex(const EventSequence& sequence, const int beats_per_bar)
 {
-    const RenderLayout layout = CalculateLayout(config);
-    
-    if (config.draw_grid)
+    if (m_index.built && m_index.generation == sequence.GetGeneration() && m_index.beats_per_bar == beats_per_bar) return;
+
+    m_index.built = true;
+    m_index.generation = sequence.GetGeneration();
+    m_index.beats_per_bar = beats_per_bar;
+
+    // stable, so notes sharing a start keep the order they were always drawn in
+    const size_t note_count = sequence.notes.size();
+    m_index.note_indices.resize(note_count);
+    for (size_t note_index = 0; note_index < note_count; ++note_index)
     {
-        DrawGrids(layout, config);
+        m_index.note_indices[note_index] = static_cast<uint32_t>(note_index);
     }
-    
-    for (const NoteEvent& note : sequence.notes)
+    std::stable_sort(m_index.note_indices.begin(), m_index.note_indices.end(),
+        [&sequence](const uint32_t left, const uint32_t right)
+        {
+            return sequence.notes[left].start_beat < sequence.notes[right].start_beat;
+        });
+
+    m_index.start_beats.resize(note_count);
+    m_index.end_beats.resize(note_count);
+    m_index.max_end_beats.resize(note_count);
+
+    float max_end_beat = std::numeric_limits<float>::lowest();
+    for (size_t order_index = 0; order_index < note_count; ++order_index)
+    {
+        const NoteEvent& note = sequence.notes[m_index.note_indices[order_index]];
+        m_index.start_beats[order_index] = note.start_beat;
+        m_index.end_beats[order_index] = CalculateVisualEndBeat(note, beats_per_bar);
+
+        max_end_beat = MaxFloat(max_end_beat, m_index.end_beats[order_index]);
+        m_index.max_end_beats[order_index] = max_end_beat;
+    }
+}
+
+void PianoRollRenderer::DrawNotes(const EventSequence& sequence, const RenderLayout& layout, const Config& config) const
+{
+    if (!config.clamp_to_view)
+    {
+        for (const NoteEvent& note : sequence.notes)
+        {
+            const NoteRenderInfo info = CalculateNoteRenderInfo(note, layout, config);
+            DrawNote(info);
+        }
+        return;
+    }
+
+    size_t first_index = 0;
+    size_t last_index = 0;
+    FindOverlappingNotes(m_index.start_beats, m_index.max_end_beats, layout.view_start_beat, layout.view_end_beat,
+                         first_index, last_index);
+
+    for (size_t order_index = first_index; order_index < last_index; ++order_index)
     {
+        if (m_index.end_beats[order_index] < layout.view_start_beat) continue;
+
+        const NoteEvent& note = sequence.notes[m_index.note_indices[order_index]];
         const NoteRenderInfo info = CalculateNoteRenderInfo(note, layout, config);
         DrawNote(info);
     }
+}
+
+PianoRollRenderer::~PianoRollRenderer()
+{
+    {
+        std::lock_guard lock(m_page_mutex);
+        m_page_quit = true;
+    }
+    m_page_wake.notify_all();
+    if (m_page_thread.joinable()) m_page_thread.join();
+
+    for (PageSlot& slot : m_page_slots)
+    {
+        Engine::DestroyTexture(slot.texture);
+        slot = PageSlot{};
+    }
+}
+
+bool PianoRollRenderer::SamePageLayout(const Config& left, const Config& right)
+{
+    // origin only moves the blit, the pages stay the same
+    return left.width == right.width && left.height == right.height &&
+           left.midi_min == right.midi_min && left.midi_max == right.midi_max &&
+           left.lane_height == right.lane_height && left.beats_per_bar == right.beats_per_bar &&
+           left.beats_per_screen == right.beats_per_screen &&
+           left.drum_track_height == right.drum_track_height && left.debug_text_height == right.debug_text_height &&
+           left.draw_grid == right.draw_grid;
+}
+
+void PianoRollRenderer::EnsurePageSource(const EventSequence& sequence, const Config& config)
+{
+    EnsureIndex(sequence, config.beats_per_bar);
+    if (m_page_source && m_page_generation == sequence.GetGeneration() && SamePageLayout(m_page_config, config)) return;
+
+    const auto source = std::make_shared<PageSource>();
+    source->id = ++m_page_source_count;
+
+    const int beats_per_bar = config.beats_per_bar > 0 ? config.beats_per_bar : 4;
+    const float pixels_per_beat = config.width / MaxFloat(1.0f, config.beats_per_screen);
+    source->page_beats = static_cast<float>(page_bars * beats_per_bar);
+
+    source->config = config;
+    source->config.origin_x = 0.0f;
+    source->config.width = source->page_beats * pixels_per_beat;
+    source->config.beats_per_screen = source->page_beats;
+    source->config.view_start_beat = 0.0f;
+    source->config.clamp_to_view = true;
+
+    const RenderLayout layout = CalculateLayout(source->config);
+    source->width = static_cast<int>(std::ceil(source->config.width));
+    source->height = static_cast<int>(std::ceil(layout.drum_height + layout.pitch_height));
+
+    source->notes.reserve(m_index.note_indices.size());
+    for (const uint32_t note_index : m_index.note_indices)
+    {
+        source->notes.push_back(sequence.notes[note_index]);
+    }
+    source->start_beats = m_index.start_beats;
+    source->end_beats = m_index.end_beats;
+    source->max_end_beats = m_index.max_end_beats;
+
+    // new page size, new textures
+    const bool resized = !m_page_source || m_page_source->width != source->width || m_page_source->height != source->height;
+    for (PageSlot& slot : m_page_slots)
+    {
+        if (resized)
+        {
+            Engine::DestroyTexture(slot.texture);
+            slot.texture = 0;
+        }
+        slot.has_page = false;
+    }
+
+    // a view straddling page seams touches one page more than it spans
+    const int view_pages = static_cast<int>(std::ceil(config.beats_per_screen / source->page_beats)) + 1;
+    const size_t slot_count = static_cast<size_t>(view_pages + prefetch_pages + spare_page_slots);
+    for (size_t slot_index = slot_count; slot_index < m_page_slots.size(); ++slot_index)
+    {
+        Engine::DestroyTexture(m_page_slots[slot_index].texture);
+    }
+    m_page_slots.resize(slot_count);
+
+    m_page_source = source;
+    m_page_config = config;
+    m_page_generation = sequence.GetGeneration();
+
+    {
+        std::lock_guard lock(m_page_mutex);
+        m_worker_source = source;
+        m_page_requests.clear();
+    }
+
+    if (!m_page_thread.joinable()) m_page_thread = std::thread(&PianoRollRenderer::PageThreadMain, this);
+}
+
+PianoRollRenderer::PageSlot* PianoRollRenderer::FindPageSlot(const int page_index)
+{
+    for (PageSlot& slot : m_page_slots)
+    {
+        if (slot.has_page && slot.page_index == page_index) return &slot;
+    }
+    return nullptr;
+}
+
+PianoRollRenderer::PageSlot* PianoRollRenderer::ChoosePageSlot(const int page_index)
+{
+    if (PageSlot* slot = FindPageSlot(page_index)) return slot;
+
+    // pages drawn this frame are never evicted
+    PageSlot* oldest = nullptr;
+    for (PageSlot& slot : m_page_slots)
+    {
+        if (!slot.has_page) return &slot;
+        if (slot.last_used_frame == m_page_frame) continue;
+        if (!oldest || slot.last_used_frame < oldest->last_used_frame) oldest = &slot;
+    }
+    return oldest;
+}
+
+void PianoRollRenderer::UploadFinishedPages()
+{
+    {
+        std::lock_guard lock(m_page_mutex);
+        std::swap(m_uploading_pages, m_page_results);
+    }
+
+    for (const PageResult& result : m_uploading_pages)
+    {
+        // rasterized for a sequence or layout that has since changed
+        if (result.source_id != m_page_source->id) continue;
+
+        PageSlot* slot = ChoosePageSlot(result.page_index);
+        if (!slot) continue;
+        if (!slot->texture) slot->texture = Engine::CreateTexture(m_page_source->width, m_page_source->height);
+        if (!slot->texture) continue;
+
+        Engine::UpdateTexture(slot->texture, result.image.pixels.data());
+        slot->has_page = true;
+        slot->page_index = result.page_index;
+        slot->last_used_frame = m_page_frame;
+    }
+
+    // hand the pixel buffers back to the worker
+    std::lock_guard lock(m_page_mutex);
+    for (PageResult& result : m_uploading_pages)
+    {
+        m_free_page_pixels.push_back(std::move(result.image.pixels));
+    }
+    m_uploading_pages.clear();
+}
+
+void PianoRollRenderer::RequestPages()
+{
+    {
+        std::lock_guard lock(m_page_mutex);
+
+        // the newest wants replace the old ones, so a seek doesn't wait behind stale pages
+        m_page_requests.clear();
+        for (const int page_index : m_wanted_pages)
+        {
+            if (m_page_busy && m_page_in_progress == page_index) continue;
+
+            bool finished = false;
+            for (const PageResult& result : m_page_results)
+            {
+                finished |= result.source_id == m_page_source->id && result.page_index == page_index;
+            }
+            if (!finished) m_page_requests.push_back(page_index);
+        }
+    }
+    m_page_wake.notify_one();
+}
+
+void PianoRollRenderer::PageThreadMain()
+{
+    Rhythm::Profiler::SetThreadName("PianoRollPages");
+
+    std::unique_lock lock(m_page_mutex);
+    while (true)
+    {
+        m_page_wake.wait(lock, [this] { return m_page_quit || !m_page_requests.empty(); });
+        if (m_page_quit) return;
+
+        const int page_index = m_page_requests.front();
+        m_page_requests.erase(m_page_requests.begin());
+        m_page_in_progress = page_index;
+        m_page_busy = true;
+
+        const std::shared_ptr<const PageSource> source = m_worker_source;
+        PageResult result;
+        result.source_id = source->id;
+        result.page_index = page_index;
+        if (!m_free_page_pixels.empty())
+        {
+            result.image.pixels = std::move(m_free_page_pixels.back());
+            m_free_page_pixels.pop_back();
+        }
+        lock.unlock();
+
+        RasterizePage(*source, page_index, result.image);
+
+        lock.lock();
+        m_page_busy = false;
+        m_page_results.push_back(std::move(result));
+    }
+}
+
+void PianoRollRenderer::RasterizePage(const PageSource& source, const int page_index, PageImage& image)
+{
+    PROFILE_ZONE("PianoRollRenderer::RasterizePage");
+
+    Config config = source.config;
+    config.view_start_beat = static_cast<float>(page_index) * source.page_beats;
+    const RenderLayout layout = CalculateLayout(config);
+
+    image.width = source.width;
+    image.height = source.height;
+    image.top_y = layout.drum_top_y + layout.drum_height;
+    image.pixels.assign(static_cast<size_t>(image.width) * static_cast<size_t>(image.height) * 4, 0);
+
+    if (config.draw_grid)
+    {
+        DrawGrids(layout, config, &image);
+    }
+
+    size_t first_index = 0;
+    size_t last_index = 0;
+    FindOverlappingNotes(source.start_beats, source.max_end_beats, layout.view_start_beat, layout.view_end_beat,
+                         first_index, last_index);
+
+    // notes keep their full extent and the page bounds clip them, so a note
+    // crossing a seam gets no edge there and matches the direct draw
+    Config note_config = config;
+    note_config.clamp_to_view = false;
+
+    for (size_t order_index = first_index; order_index < last_index; ++order_index)
+    {
+        if (source.end_beats[order_index] < layout.view_start_beat) continue;
+
+        const NoteRenderInfo info = CalculateNoteRenderInfo(source.notes[order_index], layout, note_config);
+        DrawNote(info, &image);
+    }
+}
+
+bool PianoRollRenderer::DrawPages(const EventSequence& sequence, const RenderLayout& layout, const Config& config)
+{
+    EnsurePageSource(sequence, config);
+    if (m_page_source->width <= 0 || m_page_source->height <= 0) return false;
+
+    ++m_page_frame;
+
+    const float page_beats = m_page_source->page_beats;
+    const int first_page = static_cast<int>(std::floor(layout.view_start_beat / page_beats));
+    const int last_page = static_cast<int>(std::floor(layout.view_end_beat / page_beats));
+
+    // claim this frame's pages before uploads pick slots to replace
+    for (int page_index = first_page; page_index <= last_page + prefetch_pages; ++page_index)
+    {
+        if (PageSlot* slot = FindPageSlot(page_index)) slot->last_used_frame = m_page_frame;
+    }
+    UploadFinishedPages();
+
+    bool visible_ready = true;
+    m_wanted_pages.clear();
+    for (int page_index = first_page; page_index <= last_page + prefetch_pages; ++page_index)
+    {
+        if (PageSlot* slot = FindPageSlot(page_index))
+        {
+            slot->last_used_frame = m_page_frame;
+            continue;
+        }
+
+        m_wanted_pages.push_back(page_index);
+        if (page_index <= last_page) visible_ready = false;
+    }
+    if (!m_wanted_pages.empty()) RequestPages();
+
+    if (!visible_ready) return false;
+
+    // each page's slice of the view, at the scroll offset
+    const float content_height = layout.drum_height + layout.pitch_height;
+    for (int page_index = first_page; page_index <= last_page; ++page_index)
+    {
+        const float page_start_beat = static_cast<float>(page_index) * page_beats;
+        const float slice_start_beat = MaxFloat(layout.view_start_beat, page_start_beat);
+        const float slice_end_beat = MinFloat(layout.view_end_beat, page_start_beat + page_beats);
+        if (slice_end_beat <= slice_start_beat) continue;
+
+        const float src_x = (slice_start_beat - page_start_beat) * layout.pixels_per_beat;
+        const float slice_width = (slice_end_beat - slice_start_beat) * layout.pixels_per_beat;
+        const float dest_x = config.origin_x + (slice_start_beat - layout.view_start_beat) * layout.pixels_per_beat;
+
+        Engine::DrawTexture(FindPageSlot(page_index)->texture,
+                            src_x, 0.0f, slice_width, content_height,
+                            dest_x, layout.pitch_top_y, slice_width, content_height);
+    }
+
+    return true;
+}
+
+void PianoRollRenderer::Draw(const EventSequence& sequence, const Config& config)
+{
+    const RenderLayout layout = CalculateLayout(config);
+
+    // the page source is laid out with clamp_to_view geometry and the blit only
+    // covers [view_start, view_end], so pages only stand in for a clamped view
+    const bool drew_pages = config.clamp_to_view && DrawPages(sequence, layout, config);
+    if (!drew_pages)
+    {
+        if (config.draw_grid)
+        {
+            DrawGrids(layout, config);
+        }
+
+        if (config.clamp_to_view) EnsureIndex(sequence, config.beats_per_bar);
+        DrawNotes(sequence, layout, config);
+    }
     
     DrawDebugPanel(layout.debug_top_y, layout.debug_height, config);
     DrawPlayhead(layout, config);
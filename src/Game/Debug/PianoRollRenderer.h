@@ -1,5 +1,12 @@
 #pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "Audio/Music/Events/EventSequence.h"
+#include "Engine/Engine.h"
 
 ////////////////////////////////////////////////////////////////////
 // Pseudo Piano Roll layout used for debugging the CompositionAPI //
@@ -15,6 +22,12 @@
 class PianoRollRenderer
 {
 public:
+    PianoRollRenderer() = default;
+    ~PianoRollRenderer();
+
+    PianoRollRenderer(const PianoRollRenderer&) = delete;
+    PianoRollRenderer& operator=(const PianoRollRenderer&) = delete;
+
     struct Config
     {
         float origin_x, origin_y, width, height;
@@ -44,9 +57,14 @@ public:
         bool clamp_to_view = true;
     };
 
-    void Draw(const EventSequence& sequence, const Config& config) const;
+    // with clamp_to_view, the grid and notes come from cached pages once they
+    // are ready, and otherwise only the notes overlapping the view are visited
+    void Draw(const EventSequence& sequence, const Config& config);
 
 private:
+    // where grid and note lines go when not straight to the frame
+    struct PageImage;
+
     // theme
     struct ThemeColours
     {
@@ -110,22 +128,28 @@ private:
     };
 
     // layout
-    RenderLayout CalculateLayout(const Config& config) const;
+    static RenderLayout CalculateLayout(const Config& config);
 
     // grid rendering
-    static void DrawGrids(const RenderLayout& layout, const Config& config);
+    static void DrawGrids(const RenderLayout& layout, const Config& config, PageImage* page = nullptr);
 
     static void DrawVerticalGridLines(float region_left_x, float region_top_y,
                                       float region_height, float view_start_beat, float view_end_beat,
                                       float pixels_per_beat, int beats_per_bar,
-                                      const ThemeColours::RGB& beat_colour, const ThemeColours::RGB& bar_colour);
+                                      const ThemeColours::RGB& beat_colour, const ThemeColours::RGB& bar_colour,
+                                      PageImage* page);
 
     static void DrawHorizontalGridLines(float region_left_x, float region_top_y, float region_width,
-                                        float region_height, int num_divisions, const ThemeColours::RGB& colour);
+                                        float region_height, int num_divisions, const ThemeColours::RGB& colour,
+                                        PageImage* page);
+
+    // a frame line, or the same line rasterized into the page
+    static void DrawRollLine(PageImage* page, float start_x, float start_y, float end_x, float end_y,
+                             const ThemeColours::RGB& colour);
 
     // note rendering
-    NoteRenderInfo CalculateNoteRenderInfo(const NoteEvent& note, const RenderLayout& layout, 
-                                           const Config& config) const;
+    static NoteRenderInfo CalculateNoteRenderInfo(const NoteEvent& note, const RenderLayout& layout,
+                                                  const Config& config);
 
     static NoteRenderInfo::Position CalculateDrumNotePosition(VoiceType voice, float start_beat,
                                                               const RenderLayout& layout, const Config& config);
@@ -135,11 +159,124 @@ private:
 
     static ThemeColours::RGB CalculateNoteColour(VoiceType voice, float velocity);
 
-    static void DrawNote(const NoteRenderInfo& info);
+    static void DrawNote(const NoteRenderInfo& info, PageImage* page = nullptr);
 
     // UI overlays
     static void DrawDebugPanel(float panel_top_y, float panel_height,
                                const Config& config);
 
     static void DrawPlayhead(const RenderLayout& layout, const Config& config);
+
+    ////////////////////
+    // Interval Index //
+    /////////////////////////////////////////////////////////////
+    // Notes ordered by start beat, with a running maximum of  //
+    // their drawn end beat. The view's end bounds the last    //
+    // candidate; the running max, being non-decreasing,      //
+    // bounds the first. Rebuilt when the sequence generation  //
+    // or the bar length (which sets drum note width) changes. //
+    /////////////////////////////////////////////////////////////
+    struct IntervalIndex
+    {
+        bool built = false;
+        uint64_t generation = 0;
+        int beats_per_bar = 0;
+
+        std::vector<uint32_t> note_indices;
+        std::vector<float> start_beats;
+        std::vector<float> end_beats;
+        std::vector<float> max_end_beats;
+    };
+
+    IntervalIndex m_index;
+
+    void EnsureIndex(const EventSequence& sequence, int beats_per_bar);
+
+    ////////////////
+    // Page Cache //
+    /////////////////////////////////////////////////////////////
+    // The grid and notes only change with the sequence, so a  //
+    // worker rasterizes them a couple of bars at a time into  //
+    // RGBA pages that the main thread uploads as textures. A  //
+    // frame blits the visible pages and draws the panel and   //
+    // playhead on top. Pages not ready yet fall back to the   //
+    // direct draw. There is a slot for every page one view    //
+    // and its prefetch can touch, and the least recently used //
+    // page not drawn this frame is replaced.                  //
+    /////////////////////////////////////////////////////////////
+
+    // rows top to bottom, row 0 at virtual y top_y
+    struct PageImage
+    {
+        int width = 0;
+        int height = 0;
+        float top_y = 0.0f;
+        std::vector<uint8_t> pixels;
+    };
+
+    // everything the worker needs to rasterize any page of one sequence and layout
+    struct PageSource
+    {
+        uint64_t id = 0;
+        Config config;          // page local: origin_x 0, one page per screen
+        float page_beats = 0.0f;
+        int width = 0;
+        int height = 0;
+
+        std::vector<NoteEvent> notes;   // in index order
+        std::vector<float> start_beats;
+        std::vector<float> end_beats;
+        std::vector<float> max_end_beats;
+    };
+
+    struct PageResult
+    {
+        uint64_t source_id = 0;
+        int page_index = 0;
+        PageImage image;
+    };
+
+    struct PageSlot
+    {
+        Engine::TextureId texture = 0;
+        bool has_page = false;
+        int page_index = 0;
+        uint64_t last_used_frame = 0;
+    };
+
+    // main thread
+    std::shared_ptr<const PageSource> m_page_source;
+    Config m_page_config{};
+    uint64_t m_page_generation = 0;
+    uint64_t m_page_source_count = 0;
+    uint64_t m_page_frame = 0;
+    std::vector<PageSlot> m_page_slots;
+    std::vector<int> m_wanted_pages;
+    std::vector<PageResult> m_uploading_pages;
+
+    // shared with the worker under m_page_mutex
+    std::thread m_page_thread;
+    std::mutex m_page_mutex;
+    std::condition_variable m_page_wake;
+    std::shared_ptr<const PageSource> m_worker_source;
+    std::vector<int> m_page_requests;
+    int m_page_in_progress = 0;
+    bool m_page_busy = false;
+    std::vector<PageResult> m_page_results;
+    std::vector<std::vector<uint8_t>> m_free_page_pixels;
+    bool m_page_quit = false;
+
+    bool DrawPages(const EventSequence& sequence, const RenderLayout& layout, const Config& config);
+    void EnsurePageSource(const EventSequence& sequence, const Config& config);
+    void UploadFinishedPages();
+    void RequestPages();
+    PageSlot* FindPageSlot(int page_index);
+    PageSlot* ChoosePageSlot(int page_index);
+    void PageThreadMain();
+
+    static bool SamePageLayout(const Config& left, const Config& right);
+    static void RasterizePage(const PageSource& source, int page_index, PageImage& image);
+
+    // direct draw of the notes overlapping the view
+    void DrawNotes(const EventSequence& sequence, const RenderLayout& layout, const Config& config) const;
 };
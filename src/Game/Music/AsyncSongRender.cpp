@@ -1,5 +1,6 @@
 ﻿#include "AsyncSongRender.h"
 #include "Music/MusicClipManager.h"
+#include "Util/Profiler.h"
 
 AsyncSongRender::~AsyncSongRender()
 {
@@ -32,6 +33,9 @@ std::string AsyncSongRender::GetError() const
 
 void AsyncSongRender::ThreadMain()
 {
+    Rhythm::Profiler::SetThreadName("SongRender");
+    PROFILE_ZONE("AsyncSongRender");
+
     bool ok = true;
 
     try
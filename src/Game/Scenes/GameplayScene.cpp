@@ -1,13 +1,59 @@
 #include "GameplayScene.h"
 #include "SceneManager.h"
 #include "Engine/Engine.h"
-#include "Audio/Music/Orchestration/GameplaySongs.h"
-#include "Audio/Music/Orchestration/TestSequences.h"
 #include "Debug/DebugLogger.h"
 #include "Gameplay/GameLogic.h"
 #include "Gameplay/RunResults.h"
+#include "Gameplay/SongCatalog.h"
 #include "UI/Core/GameUI.h"
 #include "UI/HUD/GameplayHUD.h"
+#include "Util/Profiler.h"
+
+namespace
+{
+    // written next to the working directory from the profiler HUD
+    constexpr const char* profiler_trace_path = "profile_trace.json";
+
+    // room for a press on every note before the recording has to grow
+    constexpr size_t replay_actions_per_note = 2;
+
+    // capture runs while the profiler HUD is up; --trace keeps it on for the whole run
+    void SyncProfilerCapture(const bool profiler_hud)
+    {
+        const bool capture = profiler_hud || Engine::GetCommandLineValue("--trace") != nullptr;
+        if (capture != Rhythm::Profiler::IsEnabled()) Rhythm::Profiler::SetEnabled(capture);
+    }
+
+    // gameplay bindings: X/A -> left, A/S -> down, B/D -> right, Y/W -> up
+    bool LaneForInputEvent(const Engine::InputEvent& event, InputLane& lane)
+    {
+        if (event.type == Engine::InputEventType::KeyDown)
+        {
+            switch (event.key)
+            {
+                case Engine::KEY_A: lane = InputLane::Left;  return true;
+                case Engine::KEY_S: lane = InputLane::Down;  return true;
+                case Engine::KEY_D: lane = InputLane::Right; return true;
+                case Engine::KEY_W: lane = InputLane::Up;    return true;
+                default: return false;
+            }
+        }
+
+        if (event.type == Engine::InputEventType::ButtonDown && event.pad == 0)
+        {
+            switch (event.button)
+            {
+                case Engine::BTN_X: lane = InputLane::Left;  return true;
+                case Engine::BTN_A: lane = InputLane::Down;  return true;
+                case Engine::BTN_B: lane = InputLane::Right; return true;
+                case Engine::BTN_Y: lane = InputLane::Up;    return true;
+                default: return false;
+            }
+        }
+
+        return false;
+    }
+}
 
 GameplayScene::GameplayScene() = default;
 
@@ -33,44 +79,21 @@ void GameplayScene::OnEnter(SceneManager& manager)
     m_game.gameplay.punish_enabled = !Scene::no_death_mode;
     m_playing = false;
     m_hud_mode = Scene::two_player_mode ? HUDMode::TwoPlayer : HUDMode::SinglePlayer;
-    m_last_bar = -1;
+    m_sim.Reset();
 
     //////////////////// 
     // Song Selection //
     //////////////////// 
-    switch (m_game_mode)
+    m_song_id = GetGameModeString();
+    if (m_game_mode == GameMode::Test)
     {
-        case GameMode::Easy:
-            m_song_id = "Easy";
-            m_seq = MakeSong_Easy(mix);
-            break;
-        case GameMode::Medium:
-            m_song_id = "Medium";
-            m_seq = MakeSong_Medium(mix);
-            break;
-        case GameMode::Hard:
-            m_song_id = "Hard";
-            m_seq = MakeSong_Hard(mix);
-            break;
-        case GameMode::Brutal:
-            m_song_id = "Brutal";
-            m_seq = MakeSong_Brutal(mix);
-            break;
-        case GameMode::Test:
-            m_song_id = "Test";
-
-            // tests for the composition API
-            //m_seq = MakeSong_CompositionAPITests(mix);
-
-            // note density test
-            m_game.gameplay.cull_notes_older_than_beats = 200.0f;
-            m_voice_follow = Rhythm::TimingTargetMode::All;
-            mix.lead_gain = 0.03f;
-            m_seq = MakeSong_NotePoolTest(mix);
-            m_game.gameplay.punish_enabled = false;
-            m_hud_mode = HUDMode::DebugRoll;
-            break;
+        // note density test
+        m_game.gameplay.cull_notes_older_than_beats = 200.0f;
+        m_voice_follow = Rhythm::TimingTargetMode::All;
+        m_game.gameplay.punish_enabled = false;
+        m_hud_mode = HUDMode::DebugRoll;
     }
+    (void)MakeSongById(m_song_id, mix, m_seq);
     
     m_game.gameplay.difficulty = m_song_id;
     
@@ -88,6 +111,11 @@ void GameplayScene::OnExit(SceneManager& manager)
 {
     if (m_playing) m_music.Stop(m_song_id);
 
+    // a run abandoned mid-song still replays up to where it stopped
+    if (m_song_ready) SaveReplay();
+    m_sim.SetRecording(nullptr);
+    SyncProfilerCapture(false);
+
     // ensure async render is finished
     m_async_render.Join();
     m_music_time.Reset();
@@ -105,6 +133,8 @@ void GameplayScene::Update(const float dt_sec)
 {
     if (!m_scenemanager) return;
 
+    m_frame_dt_sec = dt_sec;
+
     // load song
     if (!m_song_ready)
     {
@@ -116,7 +146,11 @@ void GameplayScene::Update(const float dt_sec)
                 m_music_time.Reset();
                 m_music.Play(m_song_id, false);
                 m_playing = true;
-                m_last_bar = -1;
+                m_sim.Reset();
+                StartRecording();
+
+                // playback starts now; the simulation must not step the time before it
+                m_song_start_ns = Engine::GetInputTimestampNS();
                 Logger::PrintLog(Logger::GAME, "Song render complete");
             }
             else
@@ -130,18 +164,8 @@ void GameplayScene::Update(const float dt_sec)
         return;
     }
 
-    // normal gameplay
-    if (m_playing)
-    {
-        m_music_time.Update(dt_sec);
-        GameLogic::Update(m_music_time, m_seq, dt_sec, m_game);
-
-        if (m_music_time.raw_seconds > m_seq.GetLengthSec())
-        {
-            m_playing = false;
-            m_game.gameplay.phase = GamePhase::GameOver;
-        }
-    }
+    // hand this frame's presses to the simulation; it judges them on its own clock
+    if (m_playing) QueueInputEvents();
 
     // removed because the song should just start when rendering is done
     // if (Engine::GetController().CheckButton(Engine::BTN_LBUMPER, true) && !m_playing)
@@ -149,7 +173,6 @@ void GameplayScene::Update(const float dt_sec)
     //     m_music_time.Reset();
     //     m_music.Play(m_song_id, false);
     //     m_playing = true;
-    //     m_last_bar = -1;
     // }
 
     // exit 
@@ -164,40 +187,20 @@ void GameplayScene::Update(const float dt_sec)
         m_hud_mode = static_cast<HUDMode>((static_cast<int>(m_hud_mode) + 1) % NumHudModes);
     }
 
-    // skip to debug piano roll
-    if (Engine::GetController().CheckButton(Engine::BTN_DPAD_DOWN, true))
+    // dump the capture for chrome://tracing or Perfetto
+    if (m_hud_mode == HUDMode::Profiler && (Engine::GetController().CheckButton(Engine::BTN_DPAD_UP, true) || Engine::WasKeyPressed(Engine::KEY_P)))
     {
-        m_hud_mode = HUDMode::DebugRoll;
+        const bool exported = Rhythm::Profiler::ExportChromeTrace(profiler_trace_path);
+        Logger::PrintLog(Logger::GAME, exported ? std::string("Profiler trace written to ") + profiler_trace_path : "Profiler trace export failed");
     }
 
-    if (m_playing)
+    // skip to debug piano roll
+    if (Engine::GetController().CheckButton(Engine::BTN_DPAD_DOWN, true))
     {
-        // gameplay input
-        auto& pad = Engine::GetController();
-        if (pad.CheckButton(Engine::BTN_X, true) || Engine::WasKeyPressed(Engine::KEY_A))
-        {
-            GameLogic::OnAction(InputLane::Left,  m_music_time, m_seq, m_game);
-        }
-        if (pad.CheckButton(Engine::BTN_A, true) || Engine::WasKeyPressed(Engine::KEY_S))
-        {
-            GameLogic::OnAction(InputLane::Down,  m_music_time, m_seq, m_game);
-        }
-        if (pad.CheckButton(Engine::BTN_B, true) || Engine::WasKeyPressed(Engine::KEY_D))
-        {
-            GameLogic::OnAction(InputLane::Right, m_music_time, m_seq, m_game);
-        }
-        if (pad.CheckButton(Engine::BTN_Y, true) || Engine::WasKeyPressed(Engine::KEY_W))
-        {
-            GameLogic::OnAction(InputLane::Up,    m_music_time, m_seq, m_game);
-        }
+        m_hud_mode = HUDMode::DebugRoll;
     }
 
-    const int bar_index = m_music_time.GetBarIndex();
-    if (m_playing && bar_index != m_last_bar)
-    {
-        GameLogic::OnBar(m_music_time, m_game, m_voice_follow);
-        m_last_bar = bar_index;
-    }
+    SyncProfilerCapture(m_hud_mode == HUDMode::Profiler);
 
     if (m_game.gameplay.phase == GamePhase::GameOver)
     {
@@ -206,6 +209,7 @@ void GameplayScene::Update(const float dt_sec)
             m_music.Stop(m_song_id);
             m_playing = false;
         }
+        SaveReplay();
 
         // two player mode
         run_results_p2 = RunResults{};
@@ -225,12 +229,85 @@ void GameplayScene::Update(const float dt_sec)
     }
 }
 
+void GameplayScene::FixedUpdate(const float step_sec)
+{
+    if (!m_playing) return;
+    if (Engine::GetFixedStepTimestampNS() <= m_song_start_ns) return;
+
+    m_step_sec = step_sec;
+
+    // the runtime's step never changes, so the first one speaks for the run
+    if (m_sim.GetStepIndex() == 0) m_replay.step_sec = step_sec;
+    m_sim.Step(step_sec, m_music_time, m_seq, m_voice_follow, m_game);
+
+    if (m_music_time.raw_seconds > m_seq.GetLengthSec())
+    {
+        m_playing = false;
+        m_game.gameplay.phase = GamePhase::GameOver;
+    }
+}
+
+// place each press on the transport timeline at the moment it happened
+void GameplayScene::QueueInputEvents()
+{
+    // the transport is at elapsed_seconds as of the last fixed step
+    const uint64_t step_ns = Engine::GetFixedStepTimestampNS();
+    const uint64_t anchor_ns = (step_ns > m_song_start_ns) ? step_ns : m_song_start_ns;
+
+    for (int event_index = 0; event_index < Engine::GetInputEventCount(); ++event_index)
+    {
+        const Engine::InputEvent& event = Engine::GetInputEvent(event_index);
+        if (event.timestamp_ns < m_song_start_ns) continue;
+
+        InputLane lane = InputLane::Up;
+        if (!LaneForInputEvent(event, lane)) continue;
+
+        const double offset_sec = (static_cast<double>(event.timestamp_ns) - static_cast<double>(anchor_ns)) / 1000000000.0;
+        (void)m_sim.QueueAction(lane, m_music_time.elapsed_seconds + offset_sec);
+    }
+}
+
+void GameplayScene::StartRecording()
+{
+    m_replay.Clear();
+    m_replay.Reserve(m_seq.notes.size() * replay_actions_per_note);
+    m_replay.song_id = m_song_id;
+    m_replay.follow_mode = m_voice_follow;
+    m_replay.audio_latency_seconds = m_music_time.audio_latency_seconds;
+    m_replay.cull_notes_older_than_beats = m_game.gameplay.cull_notes_older_than_beats;
+    m_replay.punish_enabled = m_game.gameplay.punish_enabled;
+    m_replay_saved = false;
+
+    m_sim.SetRecording(&m_replay);
+}
+
+// --record <path> keeps the run for ReplayRunner
+void GameplayScene::SaveReplay()
+{
+    if (m_replay_saved) return;
+    m_replay_saved = true;
+
+    m_sim.FinishRecording(m_game);
+
+    const char* replay_path = Engine::GetCommandLineValue("--record");
+    if (!replay_path) return;
+
+    const bool saved = m_replay.SaveToFile(replay_path);
+    Logger::PrintLog(Logger::GAME, saved ? std::string("Replay written to ") + replay_path : "Replay save failed");
+}
+
 void GameplayScene::Render()
 {
     if (!m_song_ready)
     {
         GameUI::PrintCenteredText("Rendering music...", true);
+        return;
     }
-    
-    else GameplayHUD::Draw(m_music_time, m_game, m_hud_mode, m_seq, m_roll);
+
+    // draw from the transport advanced to this frame, between fixed steps
+    MusicTransport render_time = m_music_time;
+    if (m_playing) render_time.Update(Engine::GetInterpolationAlpha() * m_step_sec);
+    render_time.dt_seconds = m_frame_dt_sec;
+
+    GameplayHUD::Draw(render_time, m_game, m_hud_mode, m_seq, m_roll);
 }
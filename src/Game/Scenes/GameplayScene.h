@@ -7,6 +7,8 @@
 #include "Debug/PianoRollRenderer.h"
 #include "Audio/Music/Events/EventSequence.h"
 #include "Gameplay/GameState.h"
+#include "Gameplay/GameSimulation.h"
+#include "Gameplay/Replay.h"
 #include "Gameplay/HUDMode.h"
 #include "Music/AsyncSongRender.h"
 #include "Transport/MusicTransport.h"
@@ -19,6 +21,7 @@ public:
     void OnEnter(SceneManager& manager) override;
     void OnExit(SceneManager& manager) override;
     void Update(float dt_sec) override;
+    void FixedUpdate(float step_sec) override;
     void Render() override;
 
 private:
@@ -29,8 +32,22 @@ private:
     GameState  m_game{};
     HUDMode    m_hud_mode{HUDMode::SinglePlayer};
 
+    GameSimulation m_sim;
+
     bool m_playing = false;
-    int  m_last_bar = -1;
+
+    // wall clock the transport is anchored to, and the last frame/step sizes
+    uint64_t m_song_start_ns = 0;
+    float m_frame_dt_sec = 0.0f;
+    float m_step_sec = 0.001f;
+
+    void QueueInputEvents();
+
+    // every run is recorded; --record writes it out when the run ends
+    Replay m_replay;
+    bool m_replay_saved = false;
+    void StartRecording();
+    void SaveReplay();
 
     /////////// 
     // Music //
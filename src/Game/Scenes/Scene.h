@@ -27,5 +27,8 @@ public:
     }
 
     virtual void Update(float dt) = 0;
+
+    // fixed-rate simulation tick; scenes without a simulation ignore it
+    virtual void FixedUpdate(float) {}
     virtual void Render() = 0;
 };
@@ -4,6 +4,8 @@
 #include "IntroScene.h"
 #include "GameplayScene.h"
 #include "EndScene.h"
+#include "StressScene.h"
+#include "Util/Profiler.h"
 
 // toggle for timing punishments
 bool Scene::no_death_mode = false;
@@ -30,6 +32,10 @@ void SceneManager::Launch(const SceneType type, const GameMode mode)
         case SceneType::End:
             SetScene(std::make_unique<EndScene>());
             break;
+
+        case SceneType::Stress:
+            SetScene(std::make_unique<StressScene>());
+            break;
     }
 }
 
@@ -56,6 +62,7 @@ void SceneManager::SetScene(std::unique_ptr<Scene> next)
 
 void SceneManager::Update(const float dt)
 {
+    PROFILE_ZONE("SceneManager::Update");
     if (m_scene) m_scene->Update(dt);
     if (m_has_pending)
     {
@@ -64,7 +71,14 @@ void SceneManager::Update(const float dt)
     }
 }
 
+void SceneManager::FixedUpdate(const float step)
+{
+    PROFILE_ZONE("SceneManager::FixedUpdate");
+    if (m_scene) m_scene->FixedUpdate(step);
+}
+
 void SceneManager::Render()
 {
+    PROFILE_ZONE("SceneManager::Render");
     if (m_scene) m_scene->Render();
 }
@@ -12,7 +12,10 @@ enum class SceneType
 {
     Intro,
     Gameplay,
-    End
+    End,
+
+    // load test, launched with --stress
+    Stress
 };
 
 enum class GameMode
@@ -34,6 +37,7 @@ public:
     void Request(SceneType type, GameMode mode = GameMode::Easy);
     void Clear();
     void Update(float dt);
+    void FixedUpdate(float step);
     void Render();
 
 private:
@@ -0,0 +1,240 @@
+#include "StressScene.h"
+#include "SceneManager.h"
+#include "Engine/Engine.h"
+#include "Debug/DebugLogger.h"
+#include "Gameplay/SongCatalog.h"
+#include "UI/HUD/GameplayHUD.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    // seed shared by every case, so a failing case reruns identically
+    constexpr uint32_t autoplay_seed = 0x5EED1234u;
+
+    constexpr int case_dimensions = Rhythm::NumTimingTargetModes * NumHudModes * NumAutoplayProfiles;
+
+    const char* TimingTargetModeName(const Rhythm::TimingTargetMode mode)
+    {
+        switch (mode)
+        {
+            case Rhythm::TimingTargetMode::Barline: return "Barline";
+            case Rhythm::TimingTargetMode::Snare: return "Snare";
+            case Rhythm::TimingTargetMode::KickAndSnare: return "KickAndSnare";
+            case Rhythm::TimingTargetMode::Melody: return "Melody";
+            case Rhythm::TimingTargetMode::All: return "All";
+            case Rhythm::TimingTargetMode::Kick: return "Kick";
+        }
+        return "Unknown";
+    }
+
+    const char* HUDModeName(const HUDMode mode)
+    {
+        switch (mode)
+        {
+            case HUDMode::SinglePlayer: return "SinglePlayer";
+            case HUDMode::TwoPlayer: return "TwoPlayer";
+            case HUDMode::DebugRoll: return "DebugRoll";
+            case HUDMode::Profiler: return "Profiler";
+        }
+        return "Unknown";
+    }
+
+    uint64_t NowNS()
+    {
+        // real time even when headless, where the runtime clock is virtual
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    double GetFlagDouble(const char* flag, const double fallback)
+    {
+        const char* value = Engine::GetCommandLineValue(flag);
+        return value ? std::strtod(value, nullptr) : fallback;
+    }
+}
+
+StressScene::StressScene() = default;
+
+void StressScene::OnEnter(SceneManager& manager)
+{
+    Scene::OnEnter(manager);
+    Logger::PrintLog(Logger::GAME, "Entering StressScene");
+
+    // --stress-song <id> narrows the run to one song
+    const char* song_filter = Engine::GetCommandLineValue("--stress-song");
+    for (const char* song_id : song_catalog_ids)
+    {
+        if (!song_filter || std::string(song_filter) == song_id) m_song_ids.emplace_back(song_id);
+    }
+
+    m_frame_dt_sec = 1.0f / APP_STRESS_FRAME_RATE;
+    m_step_sec = 1.0f / APP_FIXED_STEP_RATE;
+    m_case_seconds = static_cast<float>(GetFlagDouble("--stress-seconds", APP_STRESS_CASE_SECONDS));
+    m_frame_budget_ms = GetFlagDouble("--stress-budget-ms", APP_STRESS_FRAME_BUDGET_MS);
+
+    m_case_count = m_song_ids.size() * case_dimensions;
+    m_frame_ns.reserve(static_cast<size_t>(APP_STRESS_FRAME_RATE * 60.0f * 10.0f));
+
+    if (m_case_count == 0) Logger::PrintLog(Logger::GAME, std::string("Stress: unknown song ") + (song_filter ? song_filter : ""));
+}
+
+void StressScene::Update(float)
+{
+    if (m_finished) return;
+
+    if (!m_case_running)
+    {
+        if (m_case_index >= m_case_count)
+        {
+            FinishRun();
+            return;
+        }
+        StartCase();
+    }
+
+    m_frame_start_ns = NowNS();
+
+    // presses go in ahead of the steps that judge them
+    m_autoplayer.QueueActions(m_music_time, m_game, m_sim);
+
+    m_frame_clock_sec += m_frame_dt_sec;
+    while (m_sim_clock_sec + m_step_sec <= m_frame_clock_sec)
+    {
+        m_sim.Step(m_step_sec, m_music_time, m_seq, m_follow_mode, m_game);
+        m_sim_clock_sec += m_step_sec;
+    }
+}
+
+void StressScene::Render()
+{
+    if (!m_case_running) return;
+
+    MusicTransport render_time = m_music_time;
+    render_time.dt_seconds = m_frame_dt_sec;
+    GameplayHUD::Draw(render_time, m_game, m_hud_mode, m_seq, m_roll);
+
+    m_frame_ns.push_back(static_cast<uint32_t>(NowNS() - m_frame_start_ns));
+
+    const GameplayHUD::FrameStats& stats = GameplayHUD::GetFrameStats();
+    m_case.max_live_notes = std::max(m_case.max_live_notes, stats.live_notes);
+    m_case.max_ghosts = std::max(m_case.max_ghosts, stats.ghosts);
+    m_case.max_particles = std::max(m_case.max_particles, stats.particles);
+
+    const bool song_over = m_music_time.raw_seconds > m_seq.GetLengthSec();
+    const bool time_up = m_case_seconds > 0.0f && m_frame_clock_sec >= static_cast<double>(m_case_seconds);
+    if (song_over || time_up) FinishCase();
+}
+
+void StressScene::StartCase()
+{
+    // decode the case index, innermost dimension first
+    size_t remainder = m_case_index;
+    m_profile = static_cast<AutoplayProfile>(remainder % NumAutoplayProfiles);
+    remainder /= NumAutoplayProfiles;
+    m_hud_mode = static_cast<HUDMode>(remainder % NumHudModes);
+    remainder /= NumHudModes;
+    m_follow_mode = static_cast<Rhythm::TimingTargetMode>(remainder % Rhythm::NumTimingTargetModes);
+    remainder /= Rhythm::NumTimingTargetModes;
+    const std::string& song_id = m_song_ids[remainder];
+
+    // songs are built once and shared by all of their cases
+    if (song_id != m_loaded_song_id)
+    {
+        MixSettings mix{};
+        (void)MakeSongById(song_id, mix, m_seq);
+        m_loaded_song_id = song_id;
+    }
+
+    // the note density test keeps its long tail on screen, as in GameplayScene;
+    // nothing is punished, so every profile plays the whole case
+    m_game = GameState{};
+    m_game.gameplay.stability = 1.0f;
+    m_game.gameplay.punish_enabled = false;
+    m_game.gameplay.difficulty = song_id;
+    if (song_id == "Test") m_game.gameplay.cull_notes_older_than_beats = 200.0f;
+
+    m_music_time = MusicTransport{};
+    m_music_time.bpm = m_seq.bpm;
+    m_music_time.beats_per_bar = m_seq.beats_per_bar;
+    m_music_time.Reset();
+
+    m_sim.Reset();
+
+    Autoplayer::Settings settings;
+    settings.profile = m_profile;
+    settings.seed = autoplay_seed;
+    m_autoplayer.Reset(settings);
+
+    m_frame_clock_sec = 0.0;
+    m_sim_clock_sec = 0.0;
+    m_frame_ns.clear();
+    m_case = CaseStats{};
+    m_case_running = true;
+}
+
+void StressScene::FinishCase()
+{
+    m_case_running = false;
+    m_case.frames = m_frame_ns.size();
+
+    if (!m_frame_ns.empty())
+    {
+        const size_t p50_index = m_frame_ns.size() / 2;
+        const size_t p99_index = (m_frame_ns.size() * 99) / 100;
+
+        std::nth_element(m_frame_ns.begin(), m_frame_ns.begin() + static_cast<std::ptrdiff_t>(p50_index), m_frame_ns.end());
+        m_case.p50_ms = static_cast<double>(m_frame_ns[p50_index]) / 1000000.0;
+
+        std::nth_element(m_frame_ns.begin(), m_frame_ns.begin() + static_cast<std::ptrdiff_t>(p99_index), m_frame_ns.end());
+        m_case.p99_ms = static_cast<double>(m_frame_ns[p99_index]) / 1000000.0;
+
+        m_case.max_ms = static_cast<double>(*std::max_element(m_frame_ns.begin(), m_frame_ns.end())) / 1000000.0;
+    }
+
+    m_case.over_budget = m_case.p99_ms > m_frame_budget_ms ||
+                         m_case.max_live_notes > APP_STRESS_MAX_LIVE_NOTES ||
+                         m_case.max_ghosts > APP_STRESS_MAX_GHOSTS;
+
+    const ScoreState& score = m_game.gameplay.score;
+    char line[256];
+    (void)snprintf(line, sizeof(line), "%s %-36s frames %5llu  p50 %.3f  p99 %.3f  max %.3f ms  live %zu  ghosts %zu  particles %zu  P%d G%d L%d M%d",
+                   m_case.over_budget ? "FAIL" : "ok  ",
+                   GetCaseName().c_str(),
+                   static_cast<unsigned long long>(m_case.frames),
+                   m_case.p50_ms, m_case.p99_ms, m_case.max_ms,
+                   m_case.max_live_notes, m_case.max_ghosts, m_case.max_particles,
+                   score.totals.perfect, score.totals.good, score.totals.late, score.totals.missed);
+    Logger::PrintLog(Logger::GAME, line);
+
+    if (m_case.over_budget) ++m_failed_cases;
+    if (m_case.p99_ms > m_worst_p99_ms)
+    {
+        m_worst_p99_ms = m_case.p99_ms;
+        m_worst_case = GetCaseName();
+    }
+
+    ++m_case_index;
+}
+
+void StressScene::FinishRun()
+{
+    m_finished = true;
+
+    char line[256];
+    (void)snprintf(line, sizeof(line), "Stress: %zu cases, %zu over budget (p99 %.2f ms, %d live notes, %d ghosts); worst p99 %.3f ms in %s",
+                   m_case_count, m_failed_cases, m_frame_budget_ms, APP_STRESS_MAX_LIVE_NOTES, APP_STRESS_MAX_GHOSTS,
+                   m_worst_p99_ms, m_worst_case.empty() ? "-" : m_worst_case.c_str());
+    Logger::PrintLog(Logger::GAME, line);
+
+    Engine::SetExitCode((m_failed_cases > 0 || m_case_count == 0) ? 1 : 0);
+    Engine::RequestQuit();
+}
+
+std::string StressScene::GetCaseName() const
+{
+    return m_loaded_song_id + "/" + TimingTargetModeName(m_follow_mode) + "/" + HUDModeName(m_hud_mode) + "/" + GetAutoplayProfileName(m_profile);
+}
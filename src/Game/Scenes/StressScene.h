@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Scenes/Scene.h"
+#include "Debug/PianoRollRenderer.h"
+#include "Audio/Music/Events/EventSequence.h"
+#include "Gameplay/Autoplay.h"
+#include "Gameplay/GameSimulation.h"
+#include "Gameplay/GameState.h"
+#include "Gameplay/HUDMode.h"
+#include "Transport/MusicTransport.h"
+#include "Targets/TimingTargetMode.h"
+
+//////////////////
+// Stress Scene //
+/////////////////////////////////////////////////////////////
+// Load test behind --stress. Autoplays every song in      //
+// every timing target mode, HUD mode and autoplay         //
+// profile, one case after another, and times each frame's //
+// simulation and HUD work. Cases over the frame, note or  //
+// ghost budgets fail the run. Best run with --headless.   //
+/////////////////////////////////////////////////////////////
+class StressScene final : public Scene
+{
+public:
+    StressScene();
+    void OnEnter(SceneManager& manager) override;
+    void Update(float dt_sec) override;
+    void Render() override;
+
+private:
+    struct CaseStats
+    {
+        uint64_t frames = 0;
+        double p50_ms = 0.0;
+        double p99_ms = 0.0;
+        double max_ms = 0.0;
+        size_t max_live_notes = 0;
+        size_t max_ghosts = 0;
+        size_t max_particles = 0;
+        bool over_budget = false;
+    };
+
+    // case order: song, timing target mode, HUD mode, autoplay profile
+    size_t m_case_index = 0;
+    size_t m_case_count = 0;
+    bool m_case_running = false;
+    bool m_finished = false;
+
+    std::vector<std::string> m_song_ids;
+    std::string m_loaded_song_id;
+    EventSequence m_seq;
+    PianoRollRenderer m_roll;
+
+    GameState m_game{};
+    GameSimulation m_sim;
+    MusicTransport m_music_time;
+    Autoplayer m_autoplayer;
+    Rhythm::TimingTargetMode m_follow_mode = Rhythm::TimingTargetMode::Kick;
+    HUDMode m_hud_mode = HUDMode::SinglePlayer;
+    AutoplayProfile m_profile = AutoplayProfile::Perfect;
+
+    // the harness runs on its own frame clock, independent of the runtime's
+    float m_frame_dt_sec = 0.0f;
+    float m_step_sec = 0.0f;
+    float m_case_seconds = 0.0f;
+    double m_frame_clock_sec = 0.0;
+    double m_sim_clock_sec = 0.0;
+
+    // budgets
+    double m_frame_budget_ms = 0.0;
+
+    // timing of the frame in flight, and every frame of the current case
+    uint64_t m_frame_start_ns = 0;
+    std::vector<uint32_t> m_frame_ns;
+    CaseStats m_case;
+
+    // totals over the run
+    size_t m_failed_cases = 0;
+    double m_worst_p99_ms = 0.0;
+    std::string m_worst_case;
+
+    void StartCase();
+    void FinishCase();
+    void FinishRun();
+    std::string GetCaseName() const;
+};
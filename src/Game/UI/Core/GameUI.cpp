@@ -1,6 +1,8 @@
 #include "GameUI.h"
+#include <array>
 #include <vector>
 #include <cmath>
+#include <cstring>
 
 #include "Math/MathUtils.h"
 
@@ -14,17 +16,19 @@
 namespace
 {
 
-   const std::vector<float>& GetUnitCircle(int segments)
+    constexpr int max_circle_segments = 256;
+
+    // unit points (segments + 1, closing back on the first) for each segment
+    // count, built the first time that count is asked for
+    const std::vector<float>& GetUnitCircle(int segments)
     {
-        segments = IntMax(8, segments);
+        segments = IntMax(8, segments < max_circle_segments ? segments : max_circle_segments);
 
-        static int cached_segments = 0;
-        static std::vector<float> unit_points;
+        static std::array<std::vector<float>, max_circle_segments + 1> unit_circles;
+        std::vector<float>& unit_points = unit_circles[segments];
 
-        if (cached_segments != segments)
+        if (unit_points.empty())
         {
-            cached_segments = segments;
-            unit_points.clear();
             unit_points.reserve(static_cast<size_t>(segments + 1) * 2);
 
             for (int segment_index = 0; segment_index <= segments; ++segment_index)
@@ -37,34 +41,174 @@ namespace
         return unit_points;
     }
 
+    // a closed band between two radii: an inner/outer vertex pair per step,
+    // stitched into a strip of quads and sent as one indexed submission
+    void DrawRingMesh(const float center_x, const float center_y, const float inner_radius, const float outer_radius,
+                      const GameUI::Colour& colour, const int segments)
+    {
+        const std::vector<float>& unit_points = GetUnitCircle(segments);
+        const int ring_segments = static_cast<int>(unit_points.size() / 2) - 1;
+
+        static std::vector<Engine::Vertex> ring_vertices;
+        static std::vector<int> ring_indices;
+        ring_vertices.clear();
+        ring_indices.clear();
+
+        for (int segment_index = 0; segment_index <= ring_segments; ++segment_index)
+        {
+            const float unit_x = unit_points[segment_index * 2];
+            const float unit_y = unit_points[segment_index * 2 + 1];
+            ring_vertices.push_back({ center_x + unit_x * inner_radius, center_y + unit_y * inner_radius, colour.red, colour.green, colour.blue, 1.0f });
+            ring_vertices.push_back({ center_x + unit_x * outer_radius, center_y + unit_y * outer_radius, colour.red, colour.green, colour.blue, 1.0f });
+        }
+
+        for (int segment_index = 0; segment_index < ring_segments; ++segment_index)
+        {
+            const int inner = segment_index * 2;
+            ring_indices.push_back(inner);
+            ring_indices.push_back(inner + 1);
+            ring_indices.push_back(inner + 3);
+            ring_indices.push_back(inner);
+            ring_indices.push_back(inner + 3);
+            ring_indices.push_back(inner + 2);
+        }
+
+        Engine::DrawGeometry(ring_vertices.data(), static_cast<int>(ring_vertices.size()), ring_indices.data(), static_cast<int>(ring_indices.size()));
+    }
+
     void DrawFilledPolygon(const std::vector<float>& vertices, const GameUI::Colour& color)
     {
         if (vertices.size() < 6) return;
 
-        constexpr float depth_z = 0.0f;
-        constexpr float w = 1.0f;
-        constexpr bool wireframe = false;
-        const float origin_x = vertices[0];
-        const float origin_y = vertices[1];
+        static std::vector<Engine::Vertex> fan_vertices;
+        static std::vector<int> fan_indices;
+        fan_vertices.clear();
+        fan_indices.clear();
+
+        for (size_t vertex_index = 0; vertex_index + 1 < vertices.size(); vertex_index += 2)
+        {
+            fan_vertices.push_back({ vertices[vertex_index], vertices[vertex_index + 1], color.red, color.green, color.blue, 1.0f });
+        }
+
+        // triangle fan around the first vertex, submitted as one batch
+        for (int fan_index = 2; fan_index < static_cast<int>(fan_vertices.size()); ++fan_index)
+        {
+            fan_indices.push_back(0);
+            fan_indices.push_back(fan_index - 1);
+            fan_indices.push_back(fan_index);
+        }
+
+        Engine::DrawGeometry(fan_vertices.data(), static_cast<int>(fan_vertices.size()), fan_indices.data(), static_cast<int>(fan_indices.size()));
+    }
+
+    //////////////////
+    // Circle Atlas //
+    /////////////////////////////////////////////////////////////
+    // One row of discs and one of rings, white with coverage  //
+    // in alpha so the vertex colour tints them. Built on the  //
+    // first sprite draw and filtered smoothly when scaled.    //
+    /////////////////////////////////////////////////////////////
+    constexpr int atlas_radius_count = 5;
+    constexpr int atlas_radii[atlas_radius_count] = { 4, 8, 16, 32, 64 };
+    constexpr int atlas_padding = 2;
+    constexpr float atlas_ring_width = 1.5f;
+
+    struct CircleAtlas
+    {
+        GameUI::CircleSprite discs[atlas_radius_count];
+        GameUI::CircleSprite rings[atlas_radius_count];
+    };
+
+    const CircleAtlas& GetCircleAtlas()
+    {
+        static CircleAtlas atlas;
+        static bool built = false;
+        if (built) return atlas;
+        built = true;
+
+        int atlas_width = 0;
+        for (const int radius : atlas_radii) atlas_width += (radius + atlas_padding) * 2;
+        const int row_height = (atlas_radii[atlas_radius_count - 1] + atlas_padding) * 2;
+        const int atlas_height = row_height * 2;
+
+        std::vector<uint8_t> pixels(static_cast<size_t>(atlas_width) * static_cast<size_t>(atlas_height) * 4, 255);
+
+        int cell_x = 0;
+        for (int radius_index = 0; radius_index < atlas_radius_count; ++radius_index)
+        {
+            const float radius = static_cast<float>(atlas_radii[radius_index]);
+            const int cell_size = (atlas_radii[radius_index] + atlas_padding) * 2;
+            const float cell_half = static_cast<float>(cell_size) * 0.5f;
+            const float ring_center = radius - atlas_ring_width * 0.5f;
+
+            for (int row = 0; row < 2; ++row)
+            {
+                const bool ring = row == 1;
+                const int cell_y = row * row_height;
+
+                // coverage of each texel by the shape, half a texel either side of the edge
+                for (int texel_y = 0; texel_y < row_height; ++texel_y)
+                {
+                    for (int texel_x = 0; texel_x < cell_size; ++texel_x)
+                    {
+                        const float offset_x = static_cast<float>(texel_x) + 0.5f - cell_half;
+                        const float offset_y = static_cast<float>(texel_y) + 0.5f - cell_half;
+                        const float distance = std::sqrt(offset_x * offset_x + offset_y * offset_y);
+
+                        const float coverage = ring
+                            ? ClampFloat(atlas_ring_width * 0.5f - std::fabs(distance - ring_center) + 0.5f, 0.0f, 1.0f)
+                            : ClampFloat(radius - distance + 0.5f, 0.0f, 1.0f);
+
+                        const size_t pixel_index = (static_cast<size_t>(cell_y + texel_y) * static_cast<size_t>(atlas_width) + static_cast<size_t>(cell_x + texel_x)) * 4;
+                        pixels[pixel_index + 3] = static_cast<uint8_t>(coverage * 255.0f + 0.5f);
+                    }
+                }
+
+                GameUI::CircleSprite& sprite = ring ? atlas.rings[radius_index] : atlas.discs[radius_index];
+                sprite.u0 = static_cast<float>(cell_x) / static_cast<float>(atlas_width);
+                sprite.v0 = static_cast<float>(cell_y) / static_cast<float>(atlas_height);
+                sprite.u1 = static_cast<float>(cell_x + cell_size) / static_cast<float>(atlas_width);
+                sprite.v1 = static_cast<float>(cell_y + cell_size) / static_cast<float>(atlas_height);
+                sprite.extent_scale = cell_half / radius;
+            }
 
-        // triangle fan
-        for (size_t vertex_index = 4; vertex_index + 1 < vertices.size(); vertex_index += 2)
+            cell_x += cell_size;
+        }
+
+        const Engine::TextureId texture = Engine::CreateTexture(atlas_width, atlas_height, true);
+        Engine::UpdateTexture(texture, pixels.data());
+        for (int radius_index = 0; radius_index < atlas_radius_count; ++radius_index)
         {
-            const float prev_x = vertices[vertex_index - 2];
-            const float prev_y = vertices[vertex_index - 1];
-            const float next_x = vertices[vertex_index];
-            const float next_y = vertices[vertex_index + 1];
-
-            Engine::DrawTriangle(
-                origin_x, origin_y, depth_z, w,
-                prev_x, prev_y, depth_z, w,
-                next_x, next_y, depth_z, w,
-                color.red, color.green, color.blue,
-                color.red, color.green, color.blue,
-                color.red, color.green, color.blue,
-                wireframe
-            );
+            atlas.discs[radius_index].texture = texture;
+            atlas.rings[radius_index].texture = texture;
         }
+
+        return atlas;
+    }
+
+    void DrawSprite(const GameUI::CircleSprite& sprite, const float center_x, const float center_y, const float radius, const GameUI::Colour& colour)
+    {
+        const float half_size = radius * sprite.extent_scale;
+        const Engine::Vertex quad_vertices[4] = {
+            { center_x - half_size, center_y - half_size, colour.red, colour.green, colour.blue, 1.0f, sprite.u0, sprite.v1 },
+            { center_x + half_size, center_y - half_size, colour.red, colour.green, colour.blue, 1.0f, sprite.u1, sprite.v1 },
+            { center_x + half_size, center_y + half_size, colour.red, colour.green, colour.blue, 1.0f, sprite.u1, sprite.v0 },
+            { center_x - half_size, center_y + half_size, colour.red, colour.green, colour.blue, 1.0f, sprite.u0, sprite.v0 },
+        };
+        const int quad_indices[6] = { 0, 1, 2, 0, 2, 3 };
+        Engine::DrawGeometry(sprite.texture, quad_vertices, 4, quad_indices, 6);
+    }
+
+    void DrawQuad(const float x_px, const float y_px, const float width, const float height, const float red, const float green, const float blue)
+    {
+        const Engine::Vertex quad_vertices[4] = {
+            { x_px, y_px, red, green, blue, 1.0f },
+            { x_px + width, y_px, red, green, blue, 1.0f },
+            { x_px + width, y_px + height, red, green, blue, 1.0f },
+            { x_px, y_px + height, red, green, blue, 1.0f },
+        };
+        const int quad_indices[6] = { 0, 1, 2, 0, 2, 3 };
+        Engine::DrawGeometry(quad_vertices, 4, quad_indices, 6);
     }
 }
 
@@ -82,44 +226,21 @@ void GameUI::DrawBox(const float x_px, const float y_px, const float width_px, c
 
 void GameUI::DrawRectangle(const float x_px, const float y_px, const float width, const float height, const Colour& colour, const bool wireframe)
 {
-    const float depth_z = 0.0f;
-    const float w = 1.0f;
-    
-    Engine::DrawTriangle(x_px, y_px, depth_z, w,
-                      x_px + width, y_px, depth_z, w,
-                      x_px + width, y_px + height, depth_z, w,
-                      colour.red, colour.green, colour.blue,
-                      colour.red, colour.green, colour.blue,
-                      colour.red, colour.green, colour.blue,
-                      wireframe);
-    
-    Engine::DrawTriangle(x_px, y_px, depth_z, w,
-                      x_px + width, y_px + height, depth_z, w,
-                      x_px, y_px + height, depth_z, w,
-                      colour.red, colour.green, colour.blue,
-                      colour.red, colour.green, colour.blue,
-                      colour.red, colour.green, colour.blue,
-                      wireframe);
+    if (wireframe)
+    {
+        // outline both triangles, diagonal included, as before
+        DrawBox(x_px, y_px, width, height, colour.red, colour.green, colour.blue);
+        Engine::DrawLine(x_px, y_px, x_px + width, y_px + height, colour.red, colour.green, colour.blue);
+        return;
+    }
+
+    DrawQuad(x_px, y_px, width, height, colour.red, colour.green, colour.blue);
 }
 
 void GameUI::DrawCircleLines(const float center_x, const float center_y, const float radius, const float red, const float green, const float blue, int segments)
 {
-    segments = IntMax(8, segments);
-
-    const std::vector<float>& unit_points = GetUnitCircle(segments);
-    float prev_x = center_x + unit_points[0] * radius;
-    float prev_y = center_y + unit_points[1] * radius;
-
-    for (int segment_index = 1; segment_index <= segments; ++segment_index)
-    {
-        const int point_index = segment_index * 2;
-        const float point_x = center_x + unit_points[point_index] * radius;
-        const float point_y = center_y + unit_points[point_index + 1] * radius;
-
-        Engine::DrawLine(prev_x, prev_y, point_x, point_y, red, green, blue);
-        prev_x = point_x;
-        prev_y = point_y;
-    }
+    // one pixel wide, like the lines it replaces
+    DrawRingMesh(center_x, center_y, radius - 0.5f, radius + 0.5f, { red, green, blue }, segments);
 }
 
 ////////////////////
@@ -127,7 +248,8 @@ void GameUI::DrawCircleLines(const float center_x, const float center_y, const f
 ////////////////////
 void GameUI::DrawFilledCircle(const float center_x, const float center_y, const float radius, const Colour& colour, int segments)
 {
-    segments = IntMax(8, segments);
+    const std::vector<float>& unit_points = GetUnitCircle(segments);
+    segments = static_cast<int>(unit_points.size() / 2) - 1;
 
     static std::vector<float> vertices;
     vertices.clear();
@@ -138,7 +260,6 @@ void GameUI::DrawFilledCircle(const float center_x, const float center_y, const
     vertices.push_back(center_y);
 
     // ring
-    const std::vector<float>& unit_points = GetUnitCircle(segments);
     for (int segment_index = 0; segment_index <= segments; ++segment_index)
     {
         const int point_index = segment_index * 2;
@@ -149,43 +270,47 @@ void GameUI::DrawFilledCircle(const float center_x, const float center_y, const
     DrawFilledPolygon(vertices, colour);
 }
 
-void GameUI::DrawShapeOutline(const float center_x, const float center_y, const float radius, const Colour& colour, const float thickness, int segments)
+const GameUI::CircleSprite& GameUI::GetCircleSprite(const float radius, const bool ring)
 {
-    segments = IntMax(8, segments);
+    const CircleAtlas& atlas = GetCircleAtlas();
 
-    const std::vector<float>& unit_points = GetUnitCircle(segments);
-    float prev_x = center_x + unit_points[0] * radius;
-    float prev_y = center_y + unit_points[1] * radius;
-
-    for (int segment_index = 1; segment_index <= segments; ++segment_index)
+    // discs scale down from the next size up; rings take the nearest size
+    // so their line stays close to atlas_ring_width
+    int radius_index = atlas_radius_count - 1;
+    for (int candidate = 0; candidate < atlas_radius_count; ++candidate)
     {
-        const int point_index = segment_index * 2;
-        const float point_x = center_x + unit_points[point_index] * radius;
-        const float point_y = center_y + unit_points[point_index + 1] * radius;
-
-        // Cheap thickness: draw a few offset lines along the normal
-        for (float offset = -thickness * 0.5f; offset <= thickness * 0.5f; offset += 0.5f)
+        const float limit = static_cast<float>(atlas_radii[candidate]) * (ring ? 1.41421356f : 1.0f);
+        if (radius <= limit)
         {
-            const float normal_x = (point_y - center_y) / (radius == 0.0f ? 1.0f : radius);
-            const float normal_y = (center_x - point_x) / (radius == 0.0f ? 1.0f : radius);
-
-            Engine::DrawLine(
-                prev_x + normal_x * offset, prev_y + normal_y * offset,
-                point_x + normal_x * offset, point_y + normal_y * offset,
-                colour.red, colour.green, colour.blue);
+            radius_index = candidate;
+            break;
         }
-
-        prev_x = point_x;
-        prev_y = point_y;
     }
+
+    return ring ? atlas.rings[radius_index] : atlas.discs[radius_index];
+}
+
+void GameUI::DrawCircleSprite(const float center_x, const float center_y, const float radius, const Colour& colour)
+{
+    DrawSprite(GetCircleSprite(radius, false), center_x, center_y, radius, colour);
+}
+
+void GameUI::DrawRingSprite(const float center_x, const float center_y, const float radius, const Colour& colour)
+{
+    DrawSprite(GetCircleSprite(radius, true), center_x, center_y, radius, colour);
+}
+
+void GameUI::DrawShapeOutline(const float center_x, const float center_y, const float radius, const Colour& colour, const float thickness, int segments)
+{
+    const float half_thickness = MaxFloat(1.0f, thickness) * 0.5f;
+    DrawRingMesh(center_x, center_y, radius - half_thickness, radius + half_thickness, colour, segments);
 }
 
 void GameUI::DrawButton(const float center_x, const float center_y, const float radius_px, const char* label, const Colour& colour)
 {
     DrawFilledCircle(center_x, center_y, radius_px, colour);
 
-    std::string label_str(label);
-    PrintTextWithOutline(center_x - static_cast<float>(label_str.length()) * 6, center_y - 4, label_str, COLOUR_WHITE);
+    PrintTextWithOutline(center_x - static_cast<float>(std::strlen(label)) * 6, center_y - 4, label, COLOUR_WHITE);
 }
 
 void GameUI::DrawControllerLayout(const float center_x, const float center_y, const float scale)
@@ -193,8 +318,8 @@ void GameUI::DrawControllerLayout(const float center_x, const float center_y, co
     const float button_radius  = 20 * scale;
     const float button_spacing = 60 * scale;
 
-    const std::string mode_label = "SELECT DIFFICULTY";
-    const float label_width = static_cast<float>(mode_label.length()) * 8;
+    const char* mode_label = "SELECT DIFFICULTY";
+    const float label_width = static_cast<float>(std::strlen(mode_label)) * 8;
     PrintTextWithOutline(center_x - label_width / 2, center_y - 200 * scale, mode_label, COLOUR_WHITE);
 
     // XBOX layout
@@ -209,19 +334,19 @@ void GameUI::DrawControllerLayout(const float center_x, const float center_y, co
     PrintTextWithOutline(center_x - 30 * scale, center_y + button_spacing + 40 * scale, "MEDIUM", COLOUR_WHITE);
 }
 
-void GameUI::PrintTextWithOutline(const float text_x, const float text_y, const std::string& text, const Colour& colour, const Colour& outline_colour)
+void GameUI::PrintTextWithOutline(const float text_x, const float text_y, const char* text, const Colour& colour, const Colour& outline_colour)
 {
     // outline
-    Engine::Print(text_x - 1, text_y - 1, text.c_str(), outline_colour.red, outline_colour.green, outline_colour.blue);
-    Engine::Print(text_x, text_y - 1, text.c_str(), outline_colour.red, outline_colour.green, outline_colour.blue);
-    Engine::Print(text_x + 1, text_y - 1, text.c_str(), outline_colour.red, outline_colour.green, outline_colour.blue);
-    Engine::Print(text_x - 1, text_y, text.c_str(), outline_colour.red, outline_colour.green, outline_colour.blue);
-    Engine::Print(text_x + 1, text_y, text.c_str(), outline_colour.red, outline_colour.green, outline_colour.blue);
-    Engine::Print(text_x - 1, text_y + 1, text.c_str(), outline_colour.red, outline_colour.green, outline_colour.blue);
-    Engine::Print(text_x, text_y + 1, text.c_str(), outline_colour.red, outline_colour.green, outline_colour.blue);
-    Engine::Print(text_x + 1, text_y + 1, text.c_str(), outline_colour.red, outline_colour.green, outline_colour.blue);
-
-    Engine::Print(text_x, text_y, text.c_str(), colour.red, colour.green, colour.blue);
+    Engine::Print(text_x - 1, text_y - 1, text, outline_colour.red, outline_colour.green, outline_colour.blue);
+    Engine::Print(text_x, text_y - 1, text, outline_colour.red, outline_colour.green, outline_colour.blue);
+    Engine::Print(text_x + 1, text_y - 1, text, outline_colour.red, outline_colour.green, outline_colour.blue);
+    Engine::Print(text_x - 1, text_y, text, outline_colour.red, outline_colour.green, outline_colour.blue);
+    Engine::Print(text_x + 1, text_y, text, outline_colour.red, outline_colour.green, outline_colour.blue);
+    Engine::Print(text_x - 1, text_y + 1, text, outline_colour.red, outline_colour.green, outline_colour.blue);
+    Engine::Print(text_x, text_y + 1, text, outline_colour.red, outline_colour.green, outline_colour.blue);
+    Engine::Print(text_x + 1, text_y + 1, text, outline_colour.red, outline_colour.green, outline_colour.blue);
+
+    Engine::Print(text_x, text_y, text, colour.red, colour.green, colour.blue);
 }
 
 void GameUI::DrawHexagon(const float center_x, const float center_y, const float radius, const float red, const float green, const float blue)
@@ -264,30 +389,9 @@ void GameUI::DrawHealthBar(const float origin_x, const float origin_y, const flo
     const float ratio = (max_value > 0.0f) ? ClampFloat(current_value / max_value, 0.0f, 1.0f) : 0.0f;
     const float fill_width = width * ratio;
 
-    const float depth_z = 0.0f;
-    const float w = 1.0f;
-
     if (ratio > 0.0f)
     {
-        Engine::DrawTriangle(
-            origin_x, origin_y, depth_z, w,
-            origin_x + fill_width, origin_y, depth_z, w,
-            origin_x, origin_y + height, depth_z, w,
-            fill_red, fill_green, fill_blue,
-            fill_red, fill_green, fill_blue,
-            fill_red, fill_green, fill_blue,
-            false
-        );
-        
-        Engine::DrawTriangle(
-            origin_x + fill_width, origin_y, depth_z, w,
-            origin_x + fill_width, origin_y + height, depth_z, w,
-            origin_x, origin_y + height, depth_z, w,
-            fill_red, fill_green, fill_blue,
-            fill_red, fill_green, fill_blue,
-            fill_red, fill_green, fill_blue,
-            false
-        );
+        DrawQuad(origin_x, origin_y, fill_width, height, fill_red, fill_green, fill_blue);
     }
 
     Engine::DrawLine(origin_x, origin_y, origin_x + width, origin_y, border_red, border_green, border_blue);
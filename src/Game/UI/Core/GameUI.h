@@ -29,11 +29,27 @@ public:
     static void DrawControllerLayout(float center_x, float center_y, float scale = 1.0f);
 
     // draw text with an outline for better visibility
-    static void PrintTextWithOutline(float text_x, float text_y, const std::string& text, const Colour& colour, const Colour& outline_colour = COLOUR_BLACK);
+    static void PrintTextWithOutline(float text_x, float text_y, const char* text, const Colour& colour, const Colour& outline_colour = COLOUR_BLACK);
 
     // draw a filled circle (using polygon approximation)
     static void DrawFilledCircle(float center_x, float center_y, float radius, const Colour& colour, int segments = 24);
 
+    // anti-aliased discs and rings pre-rasterized at a few radii; each one
+    // is a single textured quad, so runs of them share one batch
+    struct CircleSprite
+    {
+        Engine::TextureId texture = 0;
+        float u0 = 0.0f;
+        float v0 = 0.0f;
+        float u1 = 0.0f;
+        float v1 = 0.0f;
+        float extent_scale = 1.0f; // quad half size over the drawn radius
+    };
+
+    static const CircleSprite& GetCircleSprite(float radius, bool ring);
+    static void DrawCircleSprite(float center_x, float center_y, float radius, const Colour& colour);
+    static void DrawRingSprite(float center_x, float center_y, float radius, const Colour& colour);
+
     // draw a circle outline
     static void DrawShapeOutline(float center_x, float center_y, float radius, const Colour& colour, float thickness = 1.0f, int segments = 24);
 
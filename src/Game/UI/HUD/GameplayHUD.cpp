@@ -8,11 +8,14 @@
 #include "UI/Core/GameUI.h"
 #include "Math/MathUtils.h"
 #include "UI/HUD/HUDSkin.h"
+#include "UI/HUD/HUDLayerCache.h"
 #include "Gameplay/HUDMode.h"
 #include "UI/HUD/Skins/HUDSkinSinglePlayer.h"
 #include "UI/HUD/Skins/HUDSkinTwoPlayer.h"
 #include "UI/HUD/Pools/Particles.h"
 #include "UI/HUD/Pools/Ghosts.h"
+#include "Util/AllocTracker.h"
+#include "Util/Profiler.h"
 
 //////////////////////
 // HUD Skin Manager //
@@ -23,8 +26,15 @@ namespace
 	HUDMode current_mode;
 	HUDParticlePool hit_particles;
 	HUDGhostPool ghost_pool;
+	HUDLayerCache layer_cache;
 	float last_hit_beat = -1.0f;
 
+	// kept across frames so ordering the notes doesn't allocate
+	std::vector<size_t> draw_order;
+	std::vector<HUDSkinEntity> draw_entities;
+
+	GameplayHUD::FrameStats hud_frame_stats;
+
 	// const char* HudModeName(HUDMode mode)
 	// {
 	// 	switch (mode)
@@ -57,6 +67,7 @@ namespace
 			delete hud_skin;
 			hud_skin = nullptr;
 		}
+		layer_cache.Clear();
 
 		current_mode = mode;
 
@@ -115,6 +126,95 @@ namespace
 			"PUNISH: %s",
 			game.gameplay.punish_enabled ? "ON" : "OFF");
 		Engine::Print(text_x, cursor_y, text_buffer);
+		cursor_y -= 25;
+
+		// input-to-judgement latency over the last second
+		const Engine::InputLatencyStats& latency = Engine::GetInputLatencyStats();
+		(void)snprintf(text_buffer, sizeof(text_buffer),
+			"INPUT: %.1fms avg | %.1fms max | %.0fHz poll",
+			latency.mean_ms,
+			latency.max_ms,
+			latency.poll_rate_hz);
+		Engine::Print(text_x, cursor_y, text_buffer);
+		cursor_y -= 25;
+
+		// frame pacing over the recent window
+		const Engine::FrameTimeStats& frame_stats = Engine::GetFrameTimeStats();
+		(void)snprintf(text_buffer, sizeof(text_buffer),
+			"FRAME: %.2fms avg | %.2fms p99 | %.2fms max",
+			frame_stats.mean_ms,
+			frame_stats.p99_ms,
+			frame_stats.max_ms);
+		Engine::Print(text_x, cursor_y, text_buffer);
+		cursor_y -= 25;
+
+		// draw submissions from the previous frame
+		const Engine::RenderStats& render_stats = Engine::GetRenderStats();
+		(void)snprintf(text_buffer, sizeof(text_buffer),
+			"DRAW: %u calls | %u batches | %u tris",
+			render_stats.draw_calls,
+			render_stats.geometry_flushes,
+			render_stats.triangles);
+		Engine::Print(text_x, cursor_y, text_buffer);
+
+		// main thread heap traffic, only counted in instrumented builds
+		if (Rhythm::AllocTracker::enabled)
+		{
+			cursor_y -= 25;
+			const Rhythm::AllocTracker::Counts& frame_allocs = Rhythm::AllocTracker::GetLastFrame();
+			(void)snprintf(text_buffer, sizeof(text_buffer),
+				"ALLOC: %llu allocs | %llu bytes | %llu frames allocated",
+				static_cast<unsigned long long>(frame_allocs.allocations),
+				static_cast<unsigned long long>(frame_allocs.bytes),
+				static_cast<unsigned long long>(Rhythm::AllocTracker::GetAllocatingFrames()));
+			Engine::Print(text_x, cursor_y, text_buffer);
+		}
+	}
+
+	//////////////////////
+	// Profiler overlay //
+	//////////////////////
+	static void DrawProfilerOverlay()
+	{
+		constexpr float panel_width = 360.0f;
+		constexpr float line_height = 16.0f;
+		const float text_x = static_cast<float>(APP_VIRTUAL_WIDTH) - panel_width;
+		float cursor_y = APP_VIRTUAL_HEIGHT - 30;
+
+		char text_buffer[128];
+		Engine::Print(text_x, cursor_y, "PROFILER  avg ms (calls)  [UP/P: export]", 1.0f, 0.8f, 0.0f);
+		cursor_y -= line_height * 1.5f;
+
+		const char* current_thread = nullptr;
+		for (size_t zone_index = 0; zone_index < Rhythm::Profiler::GetFrameZoneCount(); ++zone_index)
+		{
+			const Rhythm::Profiler::FrameZone& zone = Rhythm::Profiler::GetFrameZone(zone_index);
+
+			// one header per thread
+			if (zone.thread_name != current_thread)
+			{
+				current_thread = zone.thread_name;
+				Engine::Print(text_x, cursor_y, current_thread, 0.5f, 0.8f, 1.0f);
+				cursor_y -= line_height;
+			}
+
+			const int indent = static_cast<int>(zone.depth) * 2;
+			const int written = snprintf(text_buffer, sizeof(text_buffer), "%*s%-*s %7.3f (%u)",
+				indent, "",
+				30 - indent, zone.name,
+				zone.average_ms,
+				zone.calls);
+
+			if (Rhythm::AllocTracker::enabled && written > 0 && static_cast<size_t>(written) < sizeof(text_buffer))
+			{
+				(void)snprintf(text_buffer + written, sizeof(text_buffer) - written, " %ua", zone.allocations);
+			}
+
+			// zones that didn't run this frame are greyed out
+			const float shade = (zone.calls > 0) ? 1.0f : 0.5f;
+			Engine::Print(text_x, cursor_y, text_buffer, shade, shade, shade);
+			cursor_y -= line_height;
+		}
 	}
 
 	///////////////////
@@ -226,6 +326,7 @@ namespace GameplayHUD
 		UpdateHitParticles(music.dt_seconds, *hud_skin, game);
 
 		// draw background elements
+		layer_cache.Draw(*hud_skin, HUDSkinLayer::Background, APP_VIRTUAL_WIDTH, APP_VIRTUAL_HEIGHT);
 		hud_skin->DrawBackground();
 
 		// draw ghost notes outside the lanes
@@ -242,45 +343,40 @@ namespace GameplayHUD
 
 		// draw particles
 		hit_particles.Draw();
+		hud_frame_stats.ghosts = hud_skin->GhostsEnabled() ? ghost_pool.GetDrawnCount() : 0;
+		hud_frame_stats.particles = hit_particles.Count();
 
 		// draw lane rails and centre lines
+		layer_cache.Draw(*hud_skin, HUDSkinLayer::Lanes, APP_VIRTUAL_WIDTH, APP_VIRTUAL_HEIGHT);
 		hud_skin->DrawLanes();
 
 		// draw all entities approaching along their lanes (far to near)
 		const float depth_scale_px = NoteDepthScalePx();
-		std::vector<size_t> draw_order;
-		draw_order.reserve(game.gameplay.note_pool.Count());
-
-		for (size_t note_index = 0; note_index < game.gameplay.note_pool.Count(); ++note_index)
-		{
-			draw_order.push_back(note_index);
-		}
+		auto& note_pool = game.gameplay.note_pool;
+		const float draw_beat = music.GetBeat();
+		if (draw_order.capacity() < GameplayPool::NotePool::max_notes) draw_order.reserve(GameplayPool::NotePool::max_notes);
+		note_pool.CollectDrawOrder(draw_beat, draw_order);
 
-		std::sort(draw_order.begin(), draw_order.end(),
-			[&](const int left_index, const int right_index)
-			{
-				const auto& left_note = game.gameplay.note_pool.GetNote(left_index);
-				const auto& right_note = game.gameplay.note_pool.GetNote(right_index);
-				if (fabsf(left_note.distance_px - right_note.distance_px) > 0.01f) return left_note.distance_px > right_note.distance_px;
-				return left_note.beat < right_note.beat;
-			});
+		if (draw_entities.capacity() < GameplayPool::NotePool::max_notes) draw_entities.reserve(GameplayPool::NotePool::max_notes);
+		draw_entities.clear();
 
 		for (auto note_index : draw_order)
 		{
-			const auto& note = game.gameplay.note_pool.GetNote(note_index);
-			const float depth_normalized = ClampFloat(note.distance_px / depth_scale_px, 0.0f, 1.0f);
+			const float depth_normalized = ClampFloat(note_pool.GetDistancePx(note_index, draw_beat) / depth_scale_px, 0.0f, 1.0f);
 
 			HUDSkinEntity entity{};
-			entity.id = note.id;
-			entity.lane = note.lane;
+			entity.id = note_pool.GetId(note_index);
+			entity.lane = note_pool.GetLane(note_index);
 			entity.depth_normalized = depth_normalized;
-			entity.size = note.size;
-			entity.consumed = note.consumed;
-
-			hud_skin->DrawEntity(entity);
+			entity.size = note_pool.GetSize(note_index);
+			entity.consumed = note_pool.IsConsumed(note_index);
+			draw_entities.push_back(entity);
 		}
 
+		hud_skin->DrawEntities(draw_entities.data(), draw_entities.size());
+
 		// draw centre reticle
+		layer_cache.Draw(*hud_skin, HUDSkinLayer::Reticle, APP_VIRTUAL_WIDTH, APP_VIRTUAL_HEIGHT);
 		hud_skin->DrawReticle();
 
 		// draw stability bar
@@ -332,7 +428,11 @@ namespace GameplayHUD
     /////////////////
 	void Draw(const MusicTransport& music, GameState& game, const HUDMode mode, const EventSequence& sequence, PianoRollRenderer& roll)
 	{
+		PROFILE_ZONE("GameplayHUD::Draw");
+
 		game.hud.hud_mode = mode;
+		hud_frame_stats = FrameStats{};
+		hud_frame_stats.live_notes = game.gameplay.note_pool.Count();
 
 		// handle cockpit modes with skins
         if (mode != HUDMode::DebugRoll) DrawGameplayHUD(music, sequence, game, mode);
@@ -342,5 +442,13 @@ namespace GameplayHUD
 		{
 			DrawDebugRoll(music, sequence, roll, game);
 		}
+
+		// profiler mode plays on the single player skin with the zone panel on top
+		if (mode == HUDMode::Profiler) DrawProfilerOverlay();
+	}
+
+	const FrameStats& GetFrameStats()
+	{
+		return hud_frame_stats;
 	}
 }
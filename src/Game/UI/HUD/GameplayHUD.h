@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include <cstddef>
 #include "Gameplay/HUDMode.h"
 #include "Transport/MusicTransport.h"
 #include "Gameplay/GameState.h"
@@ -9,4 +10,14 @@
 namespace GameplayHUD
 {
     void Draw(const MusicTransport& music, GameState& game, HUDMode mode, const EventSequence& sequence, PianoRollRenderer& roll);
+
+    // what the last Draw put on screen, for load tests
+    struct FrameStats
+    {
+        size_t live_notes = 0;
+        size_t ghosts = 0;
+        size_t particles = 0;
+    };
+
+    const FrameStats& GetFrameStats();
 }
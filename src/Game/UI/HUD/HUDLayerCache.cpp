@@ -0,0 +1,62 @@
+#include "UI/HUD/HUDLayerCache.h"
+
+#include <cmath>
+
+void HUDLayerCache::Clear()
+{
+    for (Layer& layer : m_layers)
+    {
+        if (layer.texture != 0) Engine::DestroyTexture(layer.texture);
+        layer = Layer{};
+    }
+}
+
+void HUDLayerCache::Draw(IHUDSkin& skin, const HUDSkinLayer layer_id, const float screen_width, const float screen_height)
+{
+    if (!skin.HasStaticLayer(layer_id)) return;
+
+    const int width = static_cast<int>(std::ceil(screen_width));
+    const int height = static_cast<int>(std::ceil(screen_height));
+    if (width <= 0 || height <= 0) return;
+
+    Layer& layer = m_layers[static_cast<int>(layer_id)];
+
+    // a new size needs a new texture
+    if (layer.texture != 0 && (layer.width != width || layer.height != height))
+    {
+        Engine::DestroyTexture(layer.texture);
+        layer = Layer{};
+    }
+
+    if (layer.texture == 0)
+    {
+        layer.texture = Engine::CreateRenderTexture(width, height);
+        layer.width = width;
+        layer.height = height;
+        layer.valid = false;
+
+        // no render textures; draw it live rather than not at all
+        if (layer.texture == 0)
+        {
+            skin.DrawStaticLayer(layer_id);
+            return;
+        }
+    }
+
+    const uint8_t lanes_mask = skin.GetActiveLanesMask();
+    const uint32_t target_generation = Engine::GetRenderTargetGeneration();
+    if (!layer.valid || layer.lanes_mask != lanes_mask || layer.target_generation != target_generation)
+    {
+        Engine::BeginRenderToTexture(layer.texture);
+        skin.DrawStaticLayer(layer_id);
+        Engine::EndRenderToTexture();
+
+        layer.lanes_mask = lanes_mask;
+        layer.target_generation = target_generation;
+        layer.valid = true;
+    }
+
+    const float layer_width = static_cast<float>(layer.width);
+    const float layer_height = static_cast<float>(layer.height);
+    Engine::DrawTexture(layer.texture, 0.0f, 0.0f, layer_width, layer_height, 0.0f, 0.0f, layer_width, layer_height);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include "Engine/Engine.h"
+#include "UI/HUD/HUDSkin.h"
+
+/////////////////////
+// HUD Layer Cache //
+/////////////////////////////////////////////////////////////
+// Keeps each static skin layer in a screen sized render   //
+// texture, so a frame blits it instead of redrawing the   //
+// same lines and circles. A layer is redrawn when its     //
+// skin, lane mask or size changes, or the device drops    //
+// render texture contents. Engine shutdown frees whatever //
+// is still held.                                          //
+/////////////////////////////////////////////////////////////
+class HUDLayerCache
+{
+public:
+    // release the textures; call when the skin changes
+    void Clear();
+
+    // blit the skin's static part of a layer, redrawing it first if stale
+    void Draw(IHUDSkin& skin, HUDSkinLayer layer, float screen_width, float screen_height);
+
+private:
+    struct Layer
+    {
+        Engine::TextureId texture = 0;
+        int width = 0;
+        int height = 0;
+        uint8_t lanes_mask = 0;
+        uint32_t target_generation = 0;
+        bool valid = false;
+    };
+
+    Layer m_layers[static_cast<int>(HUDSkinLayer::Count)];
+};
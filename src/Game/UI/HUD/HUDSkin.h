@@ -18,6 +18,25 @@ struct HUDSkinEntity
     bool consumed;
 };
 
+// a ghost already placed along its path
+struct HUDSkinGhost
+{
+    float position_x = 0.0f;
+    float position_y = 0.0f;
+    float depth_normalized = 0.0f;
+    float alpha = 0.0f;
+    float size = 0.0f;
+};
+
+// HUD passes whose fixed parts can be drawn once and reused
+enum class HUDSkinLayer
+{
+    Background,
+    Lanes,
+    Reticle,
+    Count
+};
+
 class IHUDSkin
 {
 public:
@@ -29,6 +48,17 @@ public:
     // draw a single entity approaching along a lane
     virtual void DrawEntity(const HUDSkinEntity& entity) = 0;
 
+    // draw every entity far to near, lanes interleaved. skins override this
+    // to work out each lane's geometry once into a table indexed by lane,
+    // then place every entity from it in one loop
+    virtual void DrawEntities(const HUDSkinEntity* entities, const size_t count)
+    {
+        for (size_t entity_index = 0; entity_index < count; ++entity_index)
+        {
+            DrawEntity(entities[entity_index]);
+        }
+    }
+
     // draw all lane rails and centerlines
     virtual void DrawLanes() = 0;
 
@@ -38,6 +68,12 @@ public:
     // draw any background or decorative elements
     virtual void DrawBackground() = 0;
 
+    // parts of a layer that don't animate. they're drawn once into a cached
+    // texture and redrawn only when the skin, its lane mask or the screen size
+    // changes; the matching Draw call then only adds what moves on top
+    virtual bool HasStaticLayer(HUDSkinLayer) const { return false; }
+    virtual void DrawStaticLayer(HUDSkinLayer) {}
+
     // get the lane direction
     virtual GameUI::Colour GetLaneColour(InputLane lane) const = 0;
 
@@ -89,7 +125,17 @@ public:
     {
         GameUI::Colour base = GetLaneColour(lane);
         GameUI::Colour ghost_color = { base.red * alpha, base.green * alpha, base.blue * alpha };
-        GameUI::DrawFilledCircle(position_x, position_y, size, ghost_color, 12);
+        GameUI::DrawCircleSprite(position_x, position_y, size, ghost_color);
+    }
+
+    // draw one lane's ghosts; same idea as DrawEntities
+    virtual void DrawGhosts(const InputLane lane, const HUDSkinGhost* ghosts, const size_t count) const
+    {
+        for (size_t ghost_index = 0; ghost_index < count; ++ghost_index)
+        {
+            const HUDSkinGhost& ghost = ghosts[ghost_index];
+            DrawGhost(ghost.position_x, ghost.position_y, lane, ghost.depth_normalized, ghost.alpha, ghost.size);
+        }
     }
 };
 
@@ -1,4 +1,5 @@
 ﻿#include "Ghosts.h"
+#include "Util/Profiler.h"
 
 // implementation
 void HUDGhostPool::Clear()
@@ -8,20 +9,14 @@ void HUDGhostPool::Clear()
         lane.clear();
     }
     
-    m_sequence = nullptr;
+    m_built = false;
     m_length_beats = -1.0f;
-    m_note_count = 0;
 }
 
 void HUDGhostPool::EnsureBuilt(const EventSequence& seq, const Rhythm::TimingTargetMode mode, const uint8_t active_lanes_mask)
 {
-    const float length = seq.GetLengthBeats();
-    const size_t count = seq.notes.size();
-
-    const bool needs_rebuild = (m_sequence != &seq || m_mode != mode || 
-        m_lanes_mask != active_lanes_mask ||
-        fabsf(length - m_length_beats) > 0.001f || 
-        count != m_note_count);
+    const bool needs_rebuild = (!m_built || m_generation != seq.GetGeneration() ||
+        m_mode != mode || m_lanes_mask != active_lanes_mask);
     
     if (needs_rebuild) Build(seq, mode, active_lanes_mask);
 }
@@ -29,6 +24,10 @@ void HUDGhostPool::EnsureBuilt(const EventSequence& seq, const Rhythm::TimingTar
 void HUDGhostPool::Draw(const EventSequence& seq, const Rhythm::TimingTargetMode mode, const float current_beat,
                         const float approach_window_beats, const IHUDSkin& skin, const uint8_t active_lanes_mask)
 {
+    PROFILE_ZONE("HUDGhostPool::Draw");
+
+    m_drawn_count = 0;
+
     EnsureBuilt(seq, mode, active_lanes_mask);
     if (Count() == 0) return;
 
@@ -41,7 +40,7 @@ void HUDGhostPool::Draw(const EventSequence& seq, const Rhythm::TimingTargetMode
     for (int lane_idx = 0; lane_idx < 4; ++lane_idx)
     {
         const InputLane lane_id = static_cast<InputLane>(lane_idx);
-        if (IsLaneActive(active_lanes_mask, lane_id)) DrawLane(lane_idx, lane_id, cutoff_beat, approach_window_beats, skin, per_lane_limit);
+        if (IsLaneActive(active_lanes_mask, lane_id)) m_drawn_count += DrawLane(lane_idx, lane_id, cutoff_beat, approach_window_beats, skin, per_lane_limit);
     }
 }
 
@@ -75,15 +74,18 @@ void HUDGhostPool::Build(const EventSequence& sequence, const Rhythm::TimingTarg
 {
     for (auto& lane : m_notes_by_lane) lane.clear();
 
-    m_sequence = &sequence;
+    m_built = true;
+    m_generation = sequence.GetGeneration();
     m_mode = mode;
     m_lanes_mask = active_lanes_mask;
     m_length_beats = sequence.GetLengthBeats();
-    m_note_count = sequence.notes.size();
 
-    const std::vector<float> beats = CollectBeats(sequence, mode);
+    CollectBeats(sequence, mode);
+
+    // a lane can't hold more than every beat; reserving that once keeps later rebuilds allocation-free
+    for (auto& lane : m_notes_by_lane) lane.reserve(m_collected_beats.size());
 
-    for (const float beat : beats)
+    for (const float beat : m_collected_beats)
     {
         GhostNote ghost;
         ghost.beat = beat;
@@ -111,9 +113,10 @@ bool HUDGhostPool::ShouldIncludeVoice(const Rhythm::TimingTargetMode mode, const
     return false;
 }
 
-std::vector<float> HUDGhostPool::CollectBeats(const EventSequence& seq, const Rhythm::TimingTargetMode mode) const
+void HUDGhostPool::CollectBeats(const EventSequence& seq, const Rhythm::TimingTargetMode mode)
 {
-    std::vector<float> beats;
+    std::vector<float>& beats = m_collected_beats;
+    beats.clear();
 
     if (mode == Rhythm::TimingTargetMode::Barline)
     {
@@ -140,15 +143,14 @@ std::vector<float> HUDGhostPool::CollectBeats(const EventSequence& seq, const Rh
     beats.erase(std::unique(beats.begin(), beats.end(),
                             [](const float a, const float b) { return fabsf(a - b) < merge_epsilon; }),
                 beats.end());
-    return beats;
 }
 
-void HUDGhostPool::DrawLane(const int lane_index, const InputLane lane_id,
+size_t HUDGhostPool::DrawLane(const int lane_index, const InputLane lane_id,
                             const float cutoff_beat, const float approach_window_beats,
-                            const IHUDSkin& skin, const size_t draw_limit) const
+                            const IHUDSkin& skin, const size_t draw_limit)
 {
     const auto& notes = m_notes_by_lane[lane_index];
-    if (notes.empty()) return;
+    if (notes.empty()) return 0;
 
     // get lane geometry
     float anchor_x, anchor_y, lane_end_x, lane_end_y;
@@ -170,7 +172,10 @@ void HUDGhostPool::DrawLane(const int lane_index, const InputLane lane_id,
     const auto first_note = std::upper_bound(notes.begin(), notes.end(), cutoff_beat,
                                              [](const float beat, const GhostNote& note) { return beat < note.beat; });
 
-    // draw notes
+    // place notes
+    if (m_lane_ghosts.capacity() < static_cast<size_t>(max_draw_notes)) m_lane_ghosts.reserve(max_draw_notes);
+    m_lane_ghosts.clear();
+
     size_t drawn = 0;
     for (auto it = first_note; it != notes.end() && drawn < draw_limit; ++it)
     {
@@ -196,11 +201,14 @@ void HUDGhostPool::DrawLane(const int lane_index, const InputLane lane_id,
         const float x = anchor_x + cosf(angle) * radius;
         const float y = anchor_y + sinf(angle) * radius;
 
-        // draw
         const float size = LerpFloat(2.0f, 3.0f, travel_progress);
         const float depth = ClampFloat((radius - inner_radius) / MaxFloat(0.001f, outer_radius - inner_radius), 0.0f, 1.0f);
-        
-        skin.DrawGhost(x, y, it->lane, depth, alpha, size);
+
+        m_lane_ghosts.push_back({ x, y, depth, alpha, size });
         ++drawn;
     }
+
+    // draw
+    skin.DrawGhosts(lane_id, m_lane_ghosts.data(), m_lane_ghosts.size());
+    return drawn;
 }
@@ -31,21 +31,27 @@ public:
     size_t Remaining(const EventSequence& seq, Rhythm::TimingTargetMode mode, uint8_t active_lanes_mask, float current_beat);
     size_t Count() const;
 
+    // ghosts drawn by the last Draw call
+    size_t GetDrawnCount() const { return m_drawn_count; }
+
 private:
     void Build(const EventSequence& sequence, Rhythm::TimingTargetMode mode, uint8_t active_lanes_mask);
     bool ShouldIncludeVoice(Rhythm::TimingTargetMode mode, VoiceType voice) const;
-    std::vector<float> CollectBeats(const EventSequence& seq, Rhythm::TimingTargetMode mode) const;
-    void DrawLane(int lane_index, InputLane lane_id, float cutoff_beat, float approach_window_beats, const IHUDSkin& skin, size_t
-                  draw_limit) const;
+    void CollectBeats(const EventSequence& seq, Rhythm::TimingTargetMode mode);
+    size_t DrawLane(int lane_index, InputLane lane_id, float cutoff_beat, float approach_window_beats, const IHUDSkin& skin, size_t
+                  draw_limit);
 
 
     static constexpr float merge_epsilon = 0.0005f;
     static constexpr float beat_bucket_scale = 1024.0f;
     static constexpr int max_draw_notes = 300;
     std::vector<GhostNote> m_notes_by_lane[4];
-    const EventSequence* m_sequence = nullptr;
+    std::vector<float> m_collected_beats; // reused across rebuilds so mode changes don't allocate
+    std::vector<HUDSkinGhost> m_lane_ghosts; // one lane's placed ghosts, handed to the skin together
+    bool m_built = false;
+    uint64_t m_generation = 0;
     Rhythm::TimingTargetMode m_mode = Rhythm::TimingTargetMode::Barline;
     uint8_t m_lanes_mask = 0;
     float m_length_beats = -1.0f;
-    size_t m_note_count = 0;
+    size_t m_drawn_count = 0;
 };
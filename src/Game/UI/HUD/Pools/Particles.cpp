@@ -3,15 +3,90 @@
 
 #include "Math/MathUtils.h"
 
+#include <algorithm>
+#include <array>
+
+namespace
+{
+    // one circle atlas quad each
+    constexpr int vertices_per_particle = 4;
+    constexpr int indices_per_particle = 6;
+
+    // bursts pick from a fixed fan of directions instead of calling cosf/sinf per particle
+    constexpr int burst_direction_count = 256;
+
+    struct DirectionTable
+    {
+        std::array<float, burst_direction_count> direction_x{};
+        std::array<float, burst_direction_count> direction_y{};
+    };
+
+    const DirectionTable& GetDirectionTable()
+    {
+        static const DirectionTable table = []
+        {
+            DirectionTable built;
+            for (int direction_index = 0; direction_index < burst_direction_count; ++direction_index)
+            {
+                const float angle = (static_cast<float>(direction_index) / static_cast<float>(burst_direction_count)) * two_pi;
+                built.direction_x[direction_index] = cosf(angle);
+                built.direction_y[direction_index] = sinf(angle);
+            }
+            return built;
+        }();
+        return table;
+    }
+}
+
+float HUDParticlePool::RandomRange(const float min_v, const float max_v)
+{
+    m_rng_state ^= m_rng_state << 13;
+    m_rng_state ^= m_rng_state >> 17;
+    m_rng_state ^= m_rng_state << 5;
+
+    // top 24 bits, so the float is exact
+    const float unit = static_cast<float>(m_rng_state >> 8) * (1.0f / 16777216.0f);
+    return min_v + (max_v - min_v) * unit;
+}
+
+void HUDParticlePool::EnsureCapacity()
+{
+    if (m_fade.size() == m_max_particles) return;
+
+    for (std::vector<float>* field : { &m_position_x, &m_position_y, &m_velocity_x, &m_velocity_y, &m_age,
+                                       &m_inverse_life, &m_fade, &m_radius, &m_red, &m_green, &m_blue })
+    {
+        field->assign(m_max_particles, 0.0f);
+    }
+
+    m_next_slot = 0;
+    m_live_count = 0;
+
+    // two triangles per particle quad
+    m_vertices.reserve(m_max_particles * vertices_per_particle);
+    m_indices.resize(m_max_particles * indices_per_particle);
+    for (size_t particle_index = 0; particle_index < m_max_particles; ++particle_index)
+    {
+        const int base_vertex = static_cast<int>(particle_index * vertices_per_particle);
+        const int quad_indices[indices_per_particle] = { 0, 1, 2, 0, 2, 3 };
+        for (int corner = 0; corner < indices_per_particle; ++corner)
+        {
+            m_indices[particle_index * indices_per_particle + corner] = base_vertex + quad_indices[corner];
+        }
+    }
+}
+
 void HUDParticlePool::Clear()
 {
-    m_particles.clear();
+    std::fill(m_fade.begin(), m_fade.end(), 0.0f);
+    m_next_slot = 0;
+    m_live_count = 0;
 }
 
 void HUDParticlePool::SetMaxParticles(const size_t max_particles)
 {
     m_max_particles = max_particles;
-    if (m_particles.size() > m_max_particles) m_particles.resize(m_max_particles);
+    EnsureCapacity();
 }
 
 void HUDParticlePool::SpawnBurst(const float center_x, const float center_y, const GameUI::Colour& colour, const int particle_count,
@@ -19,31 +94,35 @@ void HUDParticlePool::SpawnBurst(const float center_x, const float center_y, con
                                         const float life_min, const float life_max,
                                         const float radius_min, const float radius_max)
 {
-    using namespace HUDParticlePoolInternal;
-
     if (particle_count <= 0 || m_max_particles == 0) return;
 
-    const size_t available = m_particles.size() < m_max_particles ? m_max_particles - m_particles.size() : 0;
+    EnsureCapacity();
+    const DirectionTable& directions = GetDirectionTable();
 
-    const int spawn_count = static_cast<int>(MinFloat(static_cast<float>(particle_count), static_cast<float>(available)));
-    if (spawn_count <= 0) return;
+    // a burst bigger than the ring only keeps its last slots' worth
+    const size_t spawn_count = std::min(static_cast<size_t>(particle_count), m_max_particles);
 
-    for (int spawn_index = 0; spawn_index < spawn_count; ++spawn_index)
+    for (size_t spawn_index = 0; spawn_index < spawn_count; ++spawn_index)
     {
-        const float angle = RandomRange(0.0f, Rhythm::kTwoPi);
+        const size_t slot = m_next_slot;
+        m_next_slot = (m_next_slot + 1) % m_max_particles;
+
+        if (m_fade[slot] <= 0.0f) ++m_live_count;
+
+        const int direction_index = static_cast<int>(RandomRange(0.0f, static_cast<float>(burst_direction_count))) % burst_direction_count;
         const float speed = RandomRange(speed_min, speed_max);
 
-        Particle particle{};
-        particle.position_x = center_x;
-        particle.position_y = center_y;
-        particle.velocity_x = cosf(angle) * speed;
-        particle.velocity_y = sinf(angle) * speed;
-        particle.age = 0.0f;
-        particle.life = RandomRange(life_min, life_max);
-        particle.radius = RandomRange(radius_min, radius_max);
-        particle.colour = colour;
-
-        m_particles.push_back(particle);
+        m_position_x[slot] = center_x;
+        m_position_y[slot] = center_y;
+        m_velocity_x[slot] = directions.direction_x[direction_index] * speed;
+        m_velocity_y[slot] = directions.direction_y[direction_index] * speed;
+        m_age[slot] = 0.0f;
+        m_inverse_life[slot] = 1.0f / MaxFloat(0.0001f, RandomRange(life_min, life_max));
+        m_fade[slot] = 1.0f;
+        m_radius[slot] = RandomRange(radius_min, radius_max);
+        m_red[slot] = colour.red;
+        m_green[slot] = colour.green;
+        m_blue[slot] = colour.blue;
     }
 }
 
@@ -51,37 +130,74 @@ void HUDParticlePool::Update(float dt_sec)
 {
     dt_sec = ClampFloat(dt_sec, 0.0f, 0.1f);
 
-    for (size_t particle_index = 0; particle_index < m_particles.size();)
+    // dead slots are stepped too; branch free keeps the loops vectorized
+    const size_t slot_count = m_fade.size();
+    float* position_x = m_position_x.data();
+    float* position_y = m_position_y.data();
+    const float* velocity_x = m_velocity_x.data();
+    const float* velocity_y = m_velocity_y.data();
+    float* age = m_age.data();
+    const float* inverse_life = m_inverse_life.data();
+    float* fade = m_fade.data();
+
+    for (size_t slot = 0; slot < slot_count; ++slot)
     {
-        Particle& particle = m_particles[particle_index];
-        particle.age += dt_sec;
+        age[slot] += dt_sec;
+    }
 
-        if (particle.age >= particle.life)
-        {
-            m_particles[particle_index] = m_particles.back();
-            m_particles.pop_back();
-            continue;
-        }
+    for (size_t slot = 0; slot < slot_count; ++slot)
+    {
+        position_x[slot] += velocity_x[slot] * dt_sec;
+        position_y[slot] += velocity_y[slot] * dt_sec;
+    }
 
-        particle.position_x += particle.velocity_x * dt_sec;
-        particle.position_y += particle.velocity_y * dt_sec;
-        ++particle_index;
+    // age never goes below zero, so only the low end needs clamping
+    for (size_t slot = 0; slot < slot_count; ++slot)
+    {
+        fade[slot] = MaxFloat(0.0f, 1.0f - age[slot] * inverse_life[slot]);
+    }
+
+    size_t live_count = 0;
+    for (size_t slot = 0; slot < slot_count; ++slot)
+    {
+        live_count += fade[slot] > 0.0f ? 1 : 0;
     }
+    m_live_count = live_count;
 }
 
-void HUDParticlePool::Draw() const
+void HUDParticlePool::Draw()
 {
-    for (const Particle& particle : m_particles)
+    if (m_live_count == 0) return;
+
+    m_vertices.clear();
+
+    Engine::TextureId texture = 0;
+    for (size_t slot = 0; slot < m_fade.size(); ++slot)
     {
-        const float life_t = 1.0f - (particle.age / particle.life);
-        const float fade = ClampFloat(life_t, 0.0f, 1.0f);
-        GameUI::Colour colour =
-        {
-            particle.colour.red * fade,
-            particle.colour.green * fade,
-            particle.colour.blue * fade
-        };
-        const float radius = particle.radius * (0.6f + 0.4f * fade);
-        GameUI::DrawFilledCircle(particle.position_x, particle.position_y, radius, colour, 16);
+        const float fade = m_fade[slot];
+        if (fade <= 0.0f) continue;
+
+        const float radius = m_radius[slot] * (0.6f + 0.4f * fade);
+        const float red = m_red[slot] * fade;
+        const float green = m_green[slot] * fade;
+        const float blue = m_blue[slot] * fade;
+
+        // every size lives in the same atlas, so the whole pool stays one call
+        const GameUI::CircleSprite& sprite = GameUI::GetCircleSprite(radius, false);
+        texture = sprite.texture;
+
+        const float half_size = radius * sprite.extent_scale;
+        const float left_x = m_position_x[slot] - half_size;
+        const float right_x = m_position_x[slot] + half_size;
+        const float bottom_y = m_position_y[slot] - half_size;
+        const float top_y = m_position_y[slot] + half_size;
+
+        m_vertices.push_back({ left_x, bottom_y, red, green, blue, 1.0f, sprite.u0, sprite.v1 });
+        m_vertices.push_back({ right_x, bottom_y, red, green, blue, 1.0f, sprite.u1, sprite.v1 });
+        m_vertices.push_back({ right_x, top_y, red, green, blue, 1.0f, sprite.u1, sprite.v0 });
+        m_vertices.push_back({ left_x, top_y, red, green, blue, 1.0f, sprite.u0, sprite.v0 });
     }
+
+    const int particle_count = static_cast<int>(m_vertices.size() / vertices_per_particle);
+    Engine::DrawGeometry(texture, m_vertices.data(), static_cast<int>(m_vertices.size()), m_indices.data(), particle_count * indices_per_particle);
 }
@@ -1,29 +1,23 @@
 #pragma once
+#include <cstdint>
 #include <vector>
+#include "Engine/Engine.h"
 #include "UI/Core/GameUI.h"
 
-#include "RhythmSettings.h"
-
 ///////////////////
 // Particle Pool //
 ///////////////////////////////////////////////////////////
 // Particles active when player successfully hits a note //
 ///////////////////////////////////////////////////////////
+// Each field is its own array over a fixed ring, so the //
+// age, position and fade passes are plain float loops   //
+// the compiler vectorizes. A full ring overwrites its   //
+// oldest slot. Draw sends every live particle as one    //
+// geometry call of circle atlas quads.                  //
+///////////////////////////////////////////////////////////
 class HUDParticlePool
 {
 public:
-    struct Particle
-    {
-        float position_x = 0.0f;
-        float position_y = 0.0f;
-        float velocity_x = 0.0f;
-        float velocity_y = 0.0f;
-        float age = 0.0f;
-        float life = 0.0f;
-        float radius = 1.0f;
-        GameUI::Colour colour{};
-    };
-
     void Clear();
     void SetMaxParticles(size_t max_particles);
     void SpawnBurst(float center_x, float center_y, const GameUI::Colour& colour, int particle_count,
@@ -31,18 +25,34 @@ public:
                     float life_min, float life_max,
                     float radius_min, float radius_max);
     void Update(float dt_sec);
-    void Draw() const;
-    size_t Count() const { return m_particles.size(); }
+    void Draw();
+    size_t Count() const { return m_live_count; }
 
 private:
-    std::vector<Particle> m_particles;
+    // a slot is live while its fade is above zero
+    std::vector<float> m_position_x;
+    std::vector<float> m_position_y;
+    std::vector<float> m_velocity_x;
+    std::vector<float> m_velocity_y;
+    std::vector<float> m_age;
+    std::vector<float> m_inverse_life;
+    std::vector<float> m_fade;
+    std::vector<float> m_radius;
+    std::vector<float> m_red;
+    std::vector<float> m_green;
+    std::vector<float> m_blue;
+
     size_t m_max_particles = 20;
-};
+    size_t m_next_slot = 0;
+    size_t m_live_count = 0;
+    uint32_t m_rng_state = 0x9E3779B9u;
 
-namespace HUDParticlePoolInternal
-{
-    inline float RandomRange(const float min_v, const float max_v)
-    {
-        return min_v + (max_v - min_v) * Rhythm::RandFloat01();
-    }
-}
+    // kept across frames; the indices only change with the capacity
+    std::vector<Engine::Vertex> m_vertices;
+    std::vector<int> m_indices;
+
+    void EnsureCapacity();
+
+    // xorshift32; min..max
+    float RandomRange(float min_v, float max_v);
+};
@@ -18,28 +18,7 @@ private:
     float metronome_pulse = 0.0f;
     float scanline_phase = 0.0f;
 
-public:
-    // initial calculations per frame
-    void BeginFrame(const float screen_w, const float screen_h, const float current_beat, const float dt_sec) override
-    {
-        this->screen_width = screen_w;
-        this->screen_height = screen_h;
-        center_x = screen_width * 0.5f;
-        center_y = screen_height * 0.5f;
-        lane_depth_px = (screen_width < screen_height ? screen_width : screen_height) * 0.30f;
-
-        static int last_beat = -1;
-        const int beat_now = static_cast<int>(floorf(current_beat));
-        if (beat_now != last_beat)
-        {
-            last_beat = beat_now;
-            metronome_pulse = 1.0f;
-        }
-        metronome_pulse = ClampFloat(metronome_pulse - dt_sec * 3.0f, 0.0f, 1.0f);
-        scanline_phase += dt_sec * 6.0f;
-    }
-    
-    void DrawBackground() override
+    void DrawHexGrid() const
     {
         for (int i = 40; static_cast<float>(i) < screen_width - 40; i += 40)
         {
@@ -48,10 +27,9 @@ public:
                 GameUI::DrawHexagon(static_cast<float>(i), static_cast<float>(j), 10, 0.1f, 0.1f, 0.1f);
             }
         }
-        GameUI::DrawScanlines(scanline_phase, 1.0f);
     }
 
-    void DrawLanes() override
+    void DrawLaneRails() const
     {
         InputLane lanes[4] = {InputLane::Up, InputLane::Right, InputLane::Down, InputLane::Left};
 
@@ -70,12 +48,55 @@ public:
                 const float marker_x = center_x + lane_direction.x_position * lane_depth_px * marker;
                 const float marker_y = center_y + lane_direction.y_position * lane_depth_px * marker;
                 
-                GameUI::DrawFilledCircle(marker_x, marker_y, 1.5f,{ lane_color.red * 0.2f,
-                                   lane_color.green * 0.2f, lane_color.blue * 0.2f }, 8);
+                GameUI::DrawCircleSprite(marker_x, marker_y, 1.5f,{ lane_color.red * 0.2f,
+                                   lane_color.green * 0.2f, lane_color.blue * 0.2f });
             }
         }
     }
 
+public:
+    // initial calculations per frame
+    void BeginFrame(const float screen_w, const float screen_h, const float current_beat, const float dt_sec) override
+    {
+        this->screen_width = screen_w;
+        this->screen_height = screen_h;
+        center_x = screen_width * 0.5f;
+        center_y = screen_height * 0.5f;
+        lane_depth_px = (screen_width < screen_height ? screen_width : screen_height) * 0.30f;
+
+        static int last_beat = -1;
+        const int beat_now = static_cast<int>(floorf(current_beat));
+        if (beat_now != last_beat)
+        {
+            last_beat = beat_now;
+            metronome_pulse = 1.0f;
+        }
+        metronome_pulse = ClampFloat(metronome_pulse - dt_sec * 3.0f, 0.0f, 1.0f);
+        scanline_phase += dt_sec * 6.0f;
+    }
+    
+    // the hex grid and lanes never move, only the scanlines and reticle pulse
+    bool HasStaticLayer(const HUDSkinLayer layer) const override
+    {
+        return layer == HUDSkinLayer::Background || layer == HUDSkinLayer::Lanes;
+    }
+
+    void DrawStaticLayer(const HUDSkinLayer layer) override
+    {
+        if (layer == HUDSkinLayer::Background) DrawHexGrid();
+        if (layer == HUDSkinLayer::Lanes) DrawLaneRails();
+    }
+
+    void DrawBackground() override
+    {
+        GameUI::DrawScanlines(scanline_phase, 1.0f);
+    }
+
+    // the rails are all in the static layer
+    void DrawLanes() override
+    {
+    }
+
     void DrawEntity(const HUDSkinEntity& entity) override
     {
         if (entity.consumed) return;
@@ -86,7 +107,36 @@ public:
 
         const float entity_size = 4.0f + entity.size * 4.0f;
         const GameUI::Colour lane_color = GetLaneColour(entity.lane);
-        GameUI::DrawFilledCircle(entity_x, entity_y, entity_size, lane_color, 16);
+        GameUI::DrawCircleSprite(entity_x, entity_y, entity_size, lane_color);
+    }
+
+    void DrawEntities(const HUDSkinEntity* entities, const size_t count) override
+    {
+        struct LaneGeometry
+        {
+            float step_x;
+            float step_y;
+            GameUI::Colour colour;
+        };
+
+        LaneGeometry lanes[InputLaneCount];
+        for (int lane_index = 0; lane_index < InputLaneCount; ++lane_index)
+        {
+            const InputLane lane = static_cast<InputLane>(lane_index);
+            const Vector2 lane_direction = GetLaneDirection(lane);
+            lanes[lane_index] = { lane_direction.x_position * lane_depth_px, lane_direction.y_position * lane_depth_px, GetLaneColour(lane) };
+        }
+
+        for (size_t entity_index = 0; entity_index < count; ++entity_index)
+        {
+            const HUDSkinEntity& entity = entities[entity_index];
+            if (entity.consumed) continue;
+
+            const LaneGeometry& lane = lanes[GetLaneIndex(entity.lane)];
+            const float entity_size = 4.0f + entity.size * 4.0f;
+            GameUI::DrawCircleSprite(center_x + lane.step_x * entity.depth_normalized, center_y + lane.step_y * entity.depth_normalized,
+                                     entity_size, lane.colour);
+        }
     }
 
     void DrawReticle() override
@@ -109,8 +159,19 @@ public:
     void DrawGhost(const float position_x, const float position_y, const InputLane lane, float /*depth_normalized*/, const float alpha, const float size) const override
     {
         const GameUI::Colour lane_color = GetLaneColour(lane);
-        GameUI::DrawShapeOutline(position_x, position_y, size + 1.0f, { lane_color.red * alpha, lane_color.green * alpha, lane_color.blue * alpha }, 1.0f, 8);
+        GameUI::DrawRingSprite(position_x, position_y, size + 1.0f, { lane_color.red * alpha, lane_color.green * alpha, lane_color.blue * alpha });
+
+    }
 
+    void DrawGhosts(const InputLane lane, const HUDSkinGhost* ghosts, const size_t count) const override
+    {
+        const GameUI::Colour lane_color = GetLaneColour(lane);
+        for (size_t ghost_index = 0; ghost_index < count; ++ghost_index)
+        {
+            const HUDSkinGhost& ghost = ghosts[ghost_index];
+            GameUI::DrawRingSprite(ghost.position_x, ghost.position_y, ghost.size + 1.0f,
+                                   { lane_color.red * ghost.alpha, lane_color.green * ghost.alpha, lane_color.blue * ghost.alpha });
+        }
     }
 
     float GetLaneDepthPixels() const override { return lane_depth_px; }
@@ -38,7 +38,20 @@ public:
         metronome_pulse = ClampFloat(metronome_pulse - dt_sec * 3.0f, 0.0f, 1.0f);
     }
 
+    // return true for layers with parts that never animate
+    bool HasStaticLayer(HUDSkinLayer) const override
+    {
+        return false;
+    }
+
+    // draw those parts; this runs once into a cached texture, not every frame
+    // redrawn when the skin, lane mask or screen size changes
+    void DrawStaticLayer(HUDSkinLayer) override
+    {
+    }
+
     // draw background
+    // anything drawn in the static background layer is already underneath
     void DrawBackground() override
     {
     }
@@ -51,8 +64,47 @@ public:
     // draw a single note entity
     // use entity.depth to place it between reticle (0) and lane end (1)
     // use entity.size to modify size
-    void DrawEntity(const HUDSkinEntity&) override
+    void DrawEntity(const HUDSkinEntity& entity) override
     {
+        if (entity.consumed) return;
+
+        float end_x = 0.0f;
+        float end_y = 0.0f;
+        SetLaneEnd(entity.lane, end_x, end_y);
+        GameUI::DrawCircleSprite(LerpFloat(center_x, end_x, entity.depth_normalized),
+                                 LerpFloat(center_y, end_y, entity.depth_normalized),
+                                 4.0f + entity.size * 4.0f, GetLaneColour(entity.lane));
+    }
+
+    // draw every entity, far to near with lanes interleaved
+    // work out anything shared by a lane (end point, colour) once into a table, then loop the entities
+    void DrawEntities(const HUDSkinEntity* entities, const size_t count) override
+    {
+        struct LaneGeometry
+        {
+            float end_x;
+            float end_y;
+            GameUI::Colour colour;
+        };
+
+        LaneGeometry lanes[InputLaneCount];
+        for (int lane_index = 0; lane_index < InputLaneCount; ++lane_index)
+        {
+            const InputLane lane = static_cast<InputLane>(lane_index);
+            SetLaneEnd(lane, lanes[lane_index].end_x, lanes[lane_index].end_y);
+            lanes[lane_index].colour = GetLaneColour(lane);
+        }
+
+        for (size_t entity_index = 0; entity_index < count; ++entity_index)
+        {
+            const HUDSkinEntity& entity = entities[entity_index];
+            if (entity.consumed) continue;
+
+            const LaneGeometry& lane = lanes[GetLaneIndex(entity.lane)];
+            GameUI::DrawCircleSprite(LerpFloat(center_x, lane.end_x, entity.depth_normalized),
+                                     LerpFloat(center_y, lane.end_y, entity.depth_normalized),
+                                     4.0f + entity.size * 4.0f, lane.colour);
+        }
     }
 
     // draw the target
@@ -112,6 +164,18 @@ public:
     {
         GameUI::Colour base = GetLaneColour(lane);
         GameUI::Colour c = { base.red * alpha, base.green * alpha, base.blue * alpha };
-        GameUI::DrawFilledCircle(x, y, radius, c, 12);
+        GameUI::DrawCircleSprite(x, y, radius, c);
+    }
+
+    // draw one lane's ghosts
+    void DrawGhosts(const InputLane lane, const HUDSkinGhost* ghosts, const size_t count) const override
+    {
+        const GameUI::Colour base = GetLaneColour(lane);
+        for (size_t ghost_index = 0; ghost_index < count; ++ghost_index)
+        {
+            const HUDSkinGhost& ghost = ghosts[ghost_index];
+            GameUI::DrawCircleSprite(ghost.position_x, ghost.position_y, ghost.size,
+                                     { base.red * ghost.alpha, base.green * ghost.alpha, base.blue * ghost.alpha });
+        }
     }
 };
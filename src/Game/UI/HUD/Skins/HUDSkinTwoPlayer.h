@@ -22,7 +22,6 @@ private:
     static constexpr float FlareSpeed = 1.15f;
     static constexpr float NoteBaseRadiusRatio = 0.012f;
     static constexpr float CenterCrossHalfRatio = 0.018f;
-    static constexpr int NoteSegments = 8;
     static constexpr int ReticleSegments = 8;
 
     float screen_width = 0.0f;
@@ -75,7 +74,7 @@ public:
         constexpr GameUI::Colour emitter_glow = { 0.2f, 0.2f, 0.25f };
         GameUI::DrawCircleLines(center_x, center_y, emitter_glow_radius, emitter_glow.red, emitter_glow.green, emitter_glow.blue, ReticleSegments);
         
-        GameUI::DrawFilledCircle(center_x, center_y, emitter_radius, { 0.9f, 0.9f, 0.9f }, NoteSegments);
+        GameUI::DrawCircleSprite(center_x, center_y, emitter_radius, { 0.9f, 0.9f, 0.9f });
 
         const float cross_half = min_dimension * CenterCrossHalfRatio;
         const float cross_alpha = 0.6f * (0.7f + 0.3f * sinf(flare_phase));
@@ -104,11 +103,11 @@ public:
                 const float marker_radius = min_dimension * LaneMarkerRadiusRatio * (1.0f - marker_ratio * 0.55f);
                 const float marker_alpha = 0.25f + 0.35f * (1.0f - marker_ratio);
 
-                GameUI::DrawFilledCircle(marker_x, marker_y, marker_radius,
+                GameUI::DrawCircleSprite(marker_x, marker_y, marker_radius,
                                 {
                                              lane_colour.red * marker_alpha, lane_colour.green * marker_alpha,
                                              lane_colour.blue * marker_alpha
-                                         }, NoteSegments);
+                                         });
             }
         }
     }
@@ -131,9 +130,8 @@ public:
 
         const GameUI::Colour lane_color = GetLaneColour(entity.lane);
         const float glow_alpha = 0.4f + 0.6f * (1.0f - entity.depth_normalized);
-        GameUI::DrawFilledCircle(position_x, position_y, entity_radius,
-                                 { lane_color.red * glow_alpha, lane_color.green * glow_alpha, lane_color.blue * glow_alpha },
-                                 NoteSegments);
+        GameUI::DrawCircleSprite(position_x, position_y, entity_radius,
+                                 { lane_color.red * glow_alpha, lane_color.green * glow_alpha, lane_color.blue * glow_alpha });
         // GameUI::DrawCircleLines(position_x, position_y, entity_radius * 1.4f,
         //                         lane_color.red * 0.25f,
         //                         lane_color.green * 0.25f,
@@ -141,6 +139,42 @@ public:
         //                         ReticleSegments);
     }
 
+    void DrawEntities(const HUDSkinEntity* entities, const size_t count) override
+    {
+        struct LaneGeometry
+        {
+            float target_x;
+            float target_y;
+            GameUI::Colour colour;
+        };
+
+        LaneGeometry lanes[InputLaneCount];
+        for (int lane_index = 0; lane_index < InputLaneCount; ++lane_index)
+        {
+            const InputLane lane = static_cast<InputLane>(lane_index);
+            GetPlayerTarget(lane, lanes[lane_index].target_x, lanes[lane_index].target_y);
+            lanes[lane_index].colour = GetLaneColour(lane);
+        }
+
+        const float base_radius = min_dimension * NoteBaseRadiusRatio;
+
+        for (size_t entity_index = 0; entity_index < count; ++entity_index)
+        {
+            const HUDSkinEntity& entity = entities[entity_index];
+            if (entity.consumed) continue;
+
+            const LaneGeometry& lane = lanes[GetLaneIndex(entity.lane)];
+            const float magnitude_scale = 1.0f + entity.size * 0.75f;
+            const float depth_scale = 1.0f - entity.depth_normalized * 0.45f;
+            const float glow_alpha = 0.4f + 0.6f * (1.0f - entity.depth_normalized);
+
+            GameUI::DrawCircleSprite(LerpFloat(lane.target_x, center_x, entity.depth_normalized),
+                                     LerpFloat(lane.target_y, center_y, entity.depth_normalized),
+                                     base_radius * magnitude_scale * depth_scale,
+                                     { lane.colour.red * glow_alpha, lane.colour.green * glow_alpha, lane.colour.blue * glow_alpha });
+        }
+    }
+
     void DrawReticle() override
     {
         InputLane lanes[2] = { InputLane::Left, InputLane::Right };
@@ -202,8 +236,19 @@ void SetGhostPathOrigin(const InputLane lane, float& origin_x, float& origin_y)
                    const float alpha, const float size) const override
     {
         const GameUI::Colour color = GetLaneColour(lane);
-        GameUI::DrawFilledCircle(pos_x, pos_y, size * 0.9f,
-            { color.red * alpha, color.green * alpha, color.blue * alpha }, 10);
+        GameUI::DrawCircleSprite(pos_x, pos_y, size * 0.9f,
+            { color.red * alpha, color.green * alpha, color.blue * alpha });
+    }
+
+    void DrawGhosts(const InputLane lane, const HUDSkinGhost* ghosts, const size_t count) const override
+    {
+        const GameUI::Colour color = GetLaneColour(lane);
+        for (size_t ghost_index = 0; ghost_index < count; ++ghost_index)
+        {
+            const HUDSkinGhost& ghost = ghosts[ghost_index];
+            GameUI::DrawCircleSprite(ghost.position_x, ghost.position_y, ghost.size * 0.9f,
+                { color.red * ghost.alpha, color.green * ghost.alpha, color.blue * ghost.alpha });
+        }
     }
 
 
@@ -5,6 +5,71 @@
 #include "Scenes/SceneManager.h"
 static SceneManager scenemanager;
 #include "Debug/DebugLogger.h"
+#include "Engine/Engine.h"
+#include "Util/Profiler.h"
+#include "Gameplay/Replay.h"
+#include "Gameplay/ReplayRunner.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+////////////
+// Replay //
+////////////
+// --replay <path> [--replay-runs N] plays a recording back with no clock or rendering,
+// checks it lands on the recorded score and reports the per-step cost
+static void RunReplay(const char* replay_path)
+{
+    Replay replay;
+    if (!replay.LoadFromFile(replay_path))
+    {
+        Logger::PrintLog(Logger::GAME, std::string("Replay load failed: ") + replay_path);
+        Engine::SetExitCode(1);
+        return;
+    }
+
+    ReplayRunner runner;
+    if (!runner.Load(replay))
+    {
+        Logger::PrintLog(Logger::GAME, "Replay song not found: " + replay.song_id);
+        Engine::SetExitCode(1);
+        return;
+    }
+
+    const char* runs_value = Engine::GetCommandLineValue("--replay-runs");
+    const long run_count = runs_value ? std::max(1L, std::strtol(runs_value, nullptr, 10)) : 1L;
+
+    long mismatches = 0;
+    double total_ms = 0.0;
+    double mean_step_us = 0.0;
+    double worst_p99_us = 0.0;
+    double worst_step_us = 0.0;
+    ReplayRunner::Result result;
+    for (long run_index = 0; run_index < run_count; ++run_index)
+    {
+        result = runner.Run();
+        if (!result.matched) ++mismatches;
+        total_ms += result.run_ms;
+        mean_step_us += result.mean_step_us;
+        worst_p99_us = std::max(worst_p99_us, result.p99_step_us);
+        worst_step_us = std::max(worst_step_us, result.max_step_us);
+    }
+    mean_step_us /= static_cast<double>(run_count);
+    if (mismatches > 0) Engine::SetExitCode(1);
+
+    char line[256];
+    (void)snprintf(line, sizeof(line), "Replay %s: %ld run(s), %ld mismatched, %llu steps, P=%d G=%d L=%d M=%d stability %.3f",
+                   replay.song_id.c_str(), run_count, mismatches, static_cast<unsigned long long>(result.steps),
+                   result.score.totals.perfect, result.score.totals.good, result.score.totals.late, result.score.totals.missed,
+                   static_cast<double>(result.stability));
+    Logger::PrintLog(Logger::GAME, line);
+
+    (void)snprintf(line, sizeof(line), "Replay cost: %.2f ms/run (%.1f runs/s), step mean %.3f us, p99 %.3f us, max %.3f us",
+                   total_ms / static_cast<double>(run_count), (total_ms > 0.0) ? 1000.0 * static_cast<double>(run_count) / total_ms : 0.0,
+                   mean_step_us, worst_p99_us, worst_step_us);
+    Logger::PrintLog(Logger::GAME, line);
+}
 
 //////////
 // Init //
@@ -12,7 +77,20 @@ static SceneManager scenemanager;
 void Init()
 {
     Logger::PrintLog(Logger::GAME, "Initializing Game");
-    scenemanager.Launch(SceneType::Intro);
+
+    // --trace <path> captures the whole run and writes it out on shutdown
+    Rhythm::Profiler::SetThreadName("Main");
+    if (Engine::GetCommandLineValue("--trace")) Rhythm::Profiler::SetEnabled(true);
+
+    if (const char* replay_path = Engine::GetCommandLineValue("--replay"))
+    {
+        RunReplay(replay_path);
+        Engine::RequestQuit();
+        return;
+    }
+
+    // --stress autoplays every song and mode, then quits with the budget verdict
+    scenemanager.Launch(Engine::HasCommandLineFlag("--stress") ? SceneType::Stress : SceneType::Intro);
 }
 
 ////////////
@@ -24,6 +102,15 @@ void Update(const float delta_time)
     scenemanager.Update(dt_sec);
 }
 
+//////////////////
+// Fixed Update //
+//////////////////
+void FixedUpdate(const float step_time)
+{
+    const float step_sec = step_time * 0.001f;
+    scenemanager.FixedUpdate(step_sec);
+}
+
 ////////////
 // Render //
 ////////////
@@ -39,4 +126,10 @@ void Shutdown()
 {
     Logger::PrintLog(Logger::GAME, "Shutdown");
     scenemanager.Clear();
+
+    if (const char* trace_path = Engine::GetCommandLineValue("--trace"))
+    {
+        const bool exported = Rhythm::Profiler::ExportChromeTrace(trace_path);
+        Logger::PrintLog(Logger::GAME, exported ? std::string("Profiler trace written to ") + trace_path : "Profiler trace export failed");
+    }
 }
@@ -0,0 +1,91 @@
+#include "Gameplay/Autoplay.h"
+
+#include <cmath>
+
+const char* GetAutoplayProfileName(const AutoplayProfile profile)
+{
+    switch (profile)
+    {
+        case AutoplayProfile::Perfect: return "Perfect";
+        case AutoplayProfile::HumanJitter: return "Human";
+        case AutoplayProfile::ButtonMash: return "Mash";
+    }
+    return "Unknown";
+}
+
+void Autoplayer::Reset(const Settings& settings)
+{
+    m_settings = settings;
+
+    // xorshift never leaves zero
+    m_rng_state = (settings.seed != 0) ? settings.seed : 1u;
+    m_last_queued_beat.fill(-INFINITY);
+    m_next_mash_seconds = 0.0;
+}
+
+void Autoplayer::QueueActions(const MusicTransport& music, const GameState& game, GameSimulation& sim, const float lookahead_sec)
+{
+    if (game.gameplay.phase != GamePhase::Playing) return;
+
+    const double horizon_seconds = music.elapsed_seconds + lookahead_sec;
+    if (m_settings.profile == AutoplayProfile::ButtonMash) QueueMashPresses(sim, horizon_seconds);
+    else QueueNotePresses(music, game, sim, horizon_seconds);
+}
+
+void Autoplayer::QueueNotePresses(const MusicTransport& music, const GameState& game, GameSimulation& sim, const double horizon_seconds)
+{
+    const auto& note_pool = game.gameplay.note_pool;
+
+    for (int lane_index = 0; lane_index < InputLaneCount; ++lane_index)
+    {
+        const InputLane lane = static_cast<InputLane>(lane_index);
+
+        // lane queues are beat-ordered, so stop at the first note past the horizon
+        for (size_t offset = 0; offset < note_pool.GetLaneQueueCount(lane); ++offset)
+        {
+            const size_t note_index = note_pool.GetIndex(note_pool.GetLaneQueueId(lane, offset));
+            if (note_index == GameplayPool::NotePool::invalid_index || note_pool.IsConsumed(note_index)) continue;
+
+            const float note_beat = note_pool.GetBeat(note_index);
+            if (note_beat <= m_last_queued_beat[lane_index]) continue;
+
+            // the transport time at which GetBeat() reaches the note
+            double press_seconds = static_cast<double>(note_beat) * 60.0 / static_cast<double>(music.bpm) + music.audio_latency_seconds;
+            if (press_seconds > horizon_seconds) break;
+
+            m_last_queued_beat[lane_index] = note_beat;
+
+            if (m_settings.profile == AutoplayProfile::HumanJitter)
+            {
+                if (NextUnit() < m_settings.skip_chance) continue;
+
+                // sum of three uniforms: a cheap bell curve around the note
+                const float spread = NextUnit() + NextUnit() + NextUnit() - 1.5f;
+                press_seconds += static_cast<double>(spread * 2.0f * m_settings.jitter_sec);
+            }
+
+            (void)sim.QueueAction(lane, press_seconds);
+        }
+    }
+}
+
+void Autoplayer::QueueMashPresses(GameSimulation& sim, const double horizon_seconds)
+{
+    const double mean_interval = 1.0 / static_cast<double>(m_settings.mash_rate_hz > 0.0f ? m_settings.mash_rate_hz : 1.0f);
+
+    while (m_next_mash_seconds <= horizon_seconds)
+    {
+        const InputLane lane = static_cast<InputLane>(static_cast<int>(NextUnit() * InputLaneCount));
+        (void)sim.QueueAction(lane, m_next_mash_seconds);
+
+        m_next_mash_seconds += mean_interval * (0.5 + static_cast<double>(NextUnit()));
+    }
+}
+
+float Autoplayer::NextUnit()
+{
+    m_rng_state ^= m_rng_state << 13;
+    m_rng_state ^= m_rng_state >> 17;
+    m_rng_state ^= m_rng_state << 5;
+    return static_cast<float>(m_rng_state >> 8) * (1.0f / 16777216.0f);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "Gameplay/GameSimulation.h"
+#include "Gameplay/GameState.h"
+#include "Gameplay/Lanes.h"
+#include "Transport/MusicTransport.h"
+
+//////////////
+// Autoplay //
+/////////////////////////////////////////////////////////////
+// A bot that plays through GameSimulation like a player   //
+// would: it watches the notes that have spawned and       //
+// queues presses for them on the transport timeline.      //
+// Profiles range from frame-perfect to random mashing,    //
+// and a seed makes every run repeatable.                  //
+/////////////////////////////////////////////////////////////
+enum class AutoplayProfile
+{
+    Perfect,
+    HumanJitter,
+    ButtonMash
+};
+
+constexpr int NumAutoplayProfiles = 3;
+
+const char* GetAutoplayProfileName(AutoplayProfile profile);
+
+class Autoplayer
+{
+public:
+    struct Settings
+    {
+        AutoplayProfile profile = AutoplayProfile::Perfect;
+        uint32_t seed = 1;
+
+        // human: timing error spread, and the share of notes let through
+        float jitter_sec = 0.030f;
+        float skip_chance = 0.05f;
+
+        // button mash: presses per second, on random lanes
+        float mash_rate_hz = 12.0f;
+    };
+
+    void Reset(const Settings& settings);
+
+    // queues presses due within the next lookahead_sec; call once per frame
+    void QueueActions(const MusicTransport& music, const GameState& game, GameSimulation& sim, float lookahead_sec = 0.25f);
+
+private:
+    Settings m_settings;
+    uint32_t m_rng_state = 1;
+    std::array<float, InputLaneCount> m_last_queued_beat{};
+    double m_next_mash_seconds = 0.0;
+
+    void QueueNotePresses(const MusicTransport& music, const GameState& game, GameSimulation& sim, double horizon_seconds);
+    void QueueMashPresses(GameSimulation& sim, double horizon_seconds);
+
+    // xorshift32; 0..1
+    float NextUnit();
+};
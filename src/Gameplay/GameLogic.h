@@ -21,11 +21,13 @@ public:
         Rhythm::TimingTargetMode follow_mode);
 
     // what happens when a player presses ABXY?
+    // input_age_sec is how long before the transport time the press happened
     static void OnAction(
         InputLane lane,
         const MusicTransport& music,
         const EventSequence& sequence,
-        GameState& game);
+        GameState& game,
+        float input_age_sec = 0.0f);
 
     // what happens every frame? 
     static void Update(
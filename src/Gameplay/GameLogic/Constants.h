@@ -3,7 +3,6 @@
 namespace GLC
 {
     static constexpr int lane_count = 4;
-    static constexpr float target_merge_eps_beats  = 0.0005f;
     static constexpr float beat_bucket_scale     = 1024.0f;
     static constexpr float neg_inf_beat = -INFINITY;
     static constexpr float pos_inf_beat =  INFINITY;
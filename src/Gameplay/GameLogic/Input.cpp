@@ -54,17 +54,22 @@ namespace
 
 void GameLogicInternal::ProcessMissedNotes(const float current_beat, const float miss_window_beats, GameState& game)
 {
-    for (size_t note_index = 0; note_index < game.gameplay.note_pool.Count(); ++note_index)
+    auto& note_pool = game.gameplay.note_pool;
+
+    // lane queues are beat-ordered, so only the front of each lane can have expired
+    for (int lane_index = 0; lane_index < InputLaneCount; ++lane_index)
     {
-        auto& note = game.gameplay.note_pool.GetNote(note_index);
-        if (note.consumed) continue;
+        const InputLane lane = static_cast<InputLane>(lane_index);
 
-        if (current_beat > note.beat + miss_window_beats)
+        for (note_pool.TrimLaneQueue(lane); note_pool.GetLaneQueueCount(lane) > 0; note_pool.TrimLaneQueue(lane))
         {
-            if (!note.miss_registered)
+            const size_t note_index = note_pool.GetIndex(note_pool.GetLaneQueueId(lane, 0));
+            if (current_beat <= note_pool.GetBeat(note_index) + miss_window_beats) break;
+
+            if (!note_pool.IsMissRegistered(note_index))
             {
-                note.miss_registered = true;
-                RegisterHit(game, TimingResult::Miss, note.lane);
+                note_pool.MarkMissRegistered(note_index);
+                RegisterHit(game, TimingResult::Miss, lane);
                 if (game.gameplay.punish_enabled && IsPunishableHUDMode(game.hud.hud_mode))
                 {
                     const float delta = game.gameplay.timing_policy.StabilityDelta(TimingResult::Miss);
@@ -72,34 +77,41 @@ void GameLogicInternal::ProcessMissedNotes(const float current_beat, const float
                     game.ClampStability();
                 }
             }
-            note.consumed = true;
+            note_pool.MarkConsumed(note_index);
         }
     }
 }
 
-void GameLogic::OnAction(const InputLane lane, const MusicTransport& music, const EventSequence&, GameState& game)
+void GameLogic::OnAction(const InputLane lane, const MusicTransport& music, const EventSequence&, GameState& game, const float input_age_sec)
 {
     // ignore input outside active gameplay
     if (game.gameplay.phase != GamePhase::Playing) return;
     if (!IsLaneActive(game.gameplay.active_lanes_mask, lane)) return;
 
-    // find the closest note on this lane
-    const float current_beat = music.GetBeat();
+    // find the closest note on this lane, judged at the moment of the press
+    const float current_beat = music.GetBeatBefore(input_age_sec);
+
+    auto& note_pool = game.gameplay.note_pool;
+    note_pool.TrimLaneQueue(lane);
 
     int best_note_index  = -1;
     float best_distance = GLC::pos_inf_beat;
 
-    for (size_t note_index = 0; note_index < game.gameplay.note_pool.Count(); ++note_index)
+    // the lane queue is beat-ordered, so stop at the first note past the current beat
+    for (size_t offset = 0; offset < note_pool.GetLaneQueueCount(lane); ++offset)
     {
-        const auto& note = game.gameplay.note_pool.GetNote(note_index);
-        if (note.consumed || note.lane != lane) continue;
+        const size_t note_index = note_pool.GetIndex(note_pool.GetLaneQueueId(lane, offset));
+        if (note_index == GameplayPool::NotePool::invalid_index || note_pool.IsConsumed(note_index)) continue;
 
-        const float distance = fabsf(current_beat - note.beat);
+        const float note_beat = note_pool.GetBeat(note_index);
+        const float distance = fabsf(current_beat - note_beat);
         if (distance < best_distance)
         {
             best_distance = distance;
             best_note_index = static_cast<int>(note_index);
         }
+
+        if (note_beat >= current_beat) break;
     }
 
     // register a miss if no target exists
@@ -111,8 +123,9 @@ void GameLogic::OnAction(const InputLane lane, const MusicTransport& music, cons
     }
 
     // evaluate the timing window for the best candidate
-    auto& note = game.gameplay.note_pool.GetNote(static_cast<size_t>(best_note_index));
-    const TimingResult result = game.gameplay.timing_policy.EvaluateBeatDelta(current_beat - note.beat);
+    const size_t note_index = static_cast<size_t>(best_note_index);
+    const float note_beat = note_pool.GetBeat(note_index);
+    const TimingResult result = game.gameplay.timing_policy.EvaluateBeatDelta(current_beat - note_beat);
 
     if (result == TimingResult::Miss)
     {
@@ -122,11 +135,11 @@ void GameLogic::OnAction(const InputLane lane, const MusicTransport& music, cons
     }
 
     // consume the note and record the hit
-    note.consumed = true;
+    note_pool.MarkConsumed(note_index);
     game.gameplay.hit_this_bar = true;
-    game.hud.last_consumed_target_beat = note.beat;
+    game.hud.last_consumed_target_beat = note_beat;
     game.hud.last_hit_lane = lane;
-    game.hud.last_hit_dist_px = note.distance_px;
+    game.hud.last_hit_dist_px = note_pool.GetDistancePx(note_index, current_beat);
 
     ApplyTimingFeedback(game, result, lane);
     ApplyStabilityDelta(game, result, false);
@@ -5,8 +5,7 @@
 #include "Gameplay/TimingUtils.h"
 #include "Math/MathUtils.h"
 #include "Config/AppConfig.h"
-#include <algorithm>
-#include <vector>
+#include "Util/Profiler.h"
 
 //////////////////////
 // Spawn Controller //
@@ -26,16 +25,6 @@ namespace
         }
     }
 
-    void DeduplicateTargets(std::vector<float>& targets)
-    {
-        std::sort(targets.begin(), targets.end());
-        targets.erase(std::unique(targets.begin(), targets.end(),
-            [](const float left, const float right)
-            {
-                return fabsf(left - right) < GLC::target_merge_eps_beats;
-            }), targets.end());
-    }
-
     // convert approach window to note speed
     float CalculateNoteSpeed(const MusicTransport& music, const float approach_window_beats, const float max_dist_px)
     {
@@ -43,6 +32,12 @@ namespace
         return (max_dist_px - GLC::entity_min_dist_px) / MaxFloat(0.0001f, window_sec);
     }
 
+    // convert approach window to note travel per beat
+    float CalculateNotePixelsPerBeat(const float approach_window_beats, const float max_dist_px)
+    {
+        return (max_dist_px - GLC::entity_min_dist_px) / MaxFloat(GLC::min_interval_beats, approach_window_beats);
+    }
+
     float ComputeInitialDistance(const MusicTransport& music,
                                  const float current_beat,
                                  const float target_beat,
@@ -60,22 +55,15 @@ namespace
         return ClampFloat(max_dist_px - distance_traveled, GLC::entity_min_dist_px, max_dist_px);
     }
 
-    // prune spawn buckets outside the window
-    void CleanupSpawnedBeatBuckets(GameState& game, const float current_beat)
+    // slide the spawn bucket window along with the current beat
+    void AdvanceSpawnedBeatBuckets(GameState& game, const float current_beat)
     {
-        const float min_beat = MaxFloat(0.0f, current_beat - GLC::spawn_bucket_keep_back_beats);
-        const float max_beat = current_beat + GLC::spawn_bucket_keep_fwd_beats;
+        using BucketWindow = decltype(game.gameplay.spawned_beat_buckets);
+        static_assert(BucketWindow::capacity >= (GLC::spawn_bucket_keep_back_beats + GLC::spawn_bucket_keep_fwd_beats) * GLC::beat_bucket_scale,
+                      "spawn bucket window is smaller than the keep range");
 
-        const uint32_t min_bucket = Rhythm::BeatBucket(min_beat, GLC::beat_bucket_scale);
-        const uint32_t max_bucket = Rhythm::BeatBucket(max_beat, GLC::beat_bucket_scale);
-
-        auto& buckets = game.gameplay.spawned_beat_buckets;
-        for (auto iterator = buckets.begin(); iterator != buckets.end();)
-        {
-            const uint32_t bucket = *iterator;
-            if (bucket < min_bucket || bucket > max_bucket) iterator = buckets.erase(iterator);
-            else ++iterator;
-        }
+        const float min_beat = MaxFloat(0.0f, current_beat - GLC::spawn_bucket_keep_back_beats);
+        game.gameplay.spawned_beat_buckets.Advance(Rhythm::BeatBucket(min_beat, GLC::beat_bucket_scale));
     }
 
     // spawn pass for upcoming beats
@@ -86,6 +74,8 @@ namespace
         const float current_beat,
         GameState& game)
     {
+        PROFILE_ZONE("SpawnNotes");
+
         // determine the spawn window for this frame
         const float approach_window_beats = GLC::entity_approach_window_beats;
         const float end_beat = current_beat + approach_window_beats;
@@ -97,8 +87,10 @@ namespace
         const float horizon = end_beat - start_beat;
         if (horizon <= 0.0f) return;
 
-        std::vector<float> targets;
-        Rhythm::CollectTimingTargets(sequence, mode, start_beat, horizon, targets);
+        // the index is sorted and de-duplicated, so this is a view, not a copy
+        auto& target_index = game.gameplay.target_index;
+        target_index.EnsureBuilt(sequence);
+        const Rhythm::TimingTargetRange targets = target_index.Query(mode, start_beat, horizon);
 
         if (targets.empty())
         {
@@ -106,24 +98,22 @@ namespace
             return;
         }
 
-        // remove near-duplicate targets
-        DeduplicateTargets(targets);
-
         // compute spawn parameters shared by all targets
         const VoiceType voice = VoiceForMode(mode);
         const float max_dist_px = APP_VIRTUAL_HEIGHT * GLC::entity_max_dist_px_ratio;
         const float speed_px_per_sec = CalculateNoteSpeed(music, approach_window_beats, max_dist_px);
+        const float speed_px_per_beat = CalculateNotePixelsPerBeat(approach_window_beats, max_dist_px);
 
-        for (float target_beat : targets)
+        for (const float target_beat : targets)
         {
             // skip targets too far behind
             if (target_beat < current_beat + GLC::entity_early_cull_beats) continue;
 
             // de-dupe by beat bucket
             const uint32_t bucket = Rhythm::BeatBucket(target_beat, GLC::beat_bucket_scale);
-            if (game.gameplay.spawned_beat_buckets.count(bucket)) continue;
+            if (game.gameplay.spawned_beat_buckets.Contains(bucket)) continue;
 
-            game.gameplay.spawned_beat_buckets.insert(bucket);
+            game.gameplay.spawned_beat_buckets.Insert(bucket);
 
             // compute initial position based on current beat
             const float initial_dist_px = ComputeInitialDistance(music, current_beat, target_beat,
@@ -138,7 +128,8 @@ namespace
                 voice,
                 1.0f,
                 initial_dist_px,
-                speed_px_per_sec);
+                speed_px_per_sec,
+                speed_px_per_beat);
         }
 
         // advance the spawn cursor beyond the window
@@ -155,13 +146,15 @@ namespace
 void GameLogicInternal::ResetSpawnState(GameState& game)
 {
     game.gameplay.note_pool.Clear();
-    game.gameplay.spawned_beat_buckets.clear();
+    game.gameplay.spawned_beat_buckets.Clear();
     game.gameplay.last_spawned_beat = GLC::neg_inf_beat;
     game.gameplay.hit_this_bar = false;
 }
 
 void GameLogic::Update(const MusicTransport& music, const EventSequence& sequence, const float dt_sec, GameState& game)
 {
+    PROFILE_ZONE("GameLogic::Update");
+
     // update UI feedback timers
     UpdateFeedbackTimer(dt_sec, game);
 
@@ -180,6 +173,7 @@ void GameLogic::Update(const MusicTransport& music, const EventSequence& sequenc
     game.hud.ghost_approach_window_beats = GLC::entity_approach_window_beats;
 
     // spawn, move, and cull notes
+    AdvanceSpawnedBeatBuckets(game, current_beat);
     SpawnNotes(music, sequence, game.gameplay.timing_mode, current_beat, game);
 
     game.gameplay.note_pool.StepMotion(dt_sec, GLC::entity_min_dist_px);
@@ -188,7 +182,6 @@ void GameLogic::Update(const MusicTransport& music, const EventSequence& sequenc
     GameLogicInternal::ProcessMissedNotes(current_beat, miss_window_beats, game);
 
     game.gameplay.note_pool.CullByBeat(current_beat, game.gameplay.cull_notes_older_than_beats);
-    CleanupSpawnedBeatBuckets(game, current_beat);
 
     // clamp stability and end the run if needed
     game.ClampStability();
@@ -0,0 +1,94 @@
+#include "Gameplay/GameSimulation.h"
+#include "Gameplay/GameLogic.h"
+#include "Util/Profiler.h"
+
+void GameSimulation::Reset()
+{
+    m_action_count = 0;
+    m_last_bar = -1;
+    m_step_index = 0;
+    m_hud_recorded = false;
+}
+
+bool GameSimulation::QueueAction(const InputLane lane, const double transport_seconds)
+{
+    if (m_action_count >= max_queued_actions) return false;
+
+    // keep the queue ordered by transport time
+    size_t insert_index = m_action_count;
+    while (insert_index > 0 && m_actions[insert_index - 1].transport_seconds > transport_seconds)
+    {
+        m_actions[insert_index] = m_actions[insert_index - 1];
+        --insert_index;
+    }
+
+    m_actions[insert_index].lane = lane;
+    m_actions[insert_index].transport_seconds = transport_seconds;
+    ++m_action_count;
+    return true;
+}
+
+void GameSimulation::Step(
+    const float step_sec,
+    MusicTransport& music,
+    const EventSequence& sequence,
+    const Rhythm::TimingTargetMode follow_mode,
+    GameState& game)
+{
+    PROFILE_ZONE("GameSimulation::Step");
+
+    if (m_recording) RecordHUDState(game);
+
+    music.Update(step_sec);
+
+    // judge presses that happened by the end of this step, before the miss pass
+    size_t applied_count = 0;
+    while (applied_count < m_action_count && m_actions[applied_count].transport_seconds <= music.elapsed_seconds)
+    {
+        const Action& action = m_actions[applied_count];
+        const float age_sec = static_cast<float>(music.elapsed_seconds - action.transport_seconds);
+        GameLogic::OnAction(action.lane, music, sequence, game, age_sec);
+        if (m_recording) m_recording->actions.push_back({m_step_index, action.lane, action.transport_seconds});
+        ++applied_count;
+    }
+
+    if (applied_count > 0)
+    {
+        for (size_t action_index = applied_count; action_index < m_action_count; ++action_index)
+        {
+            m_actions[action_index - applied_count] = m_actions[action_index];
+        }
+        m_action_count -= applied_count;
+    }
+
+    GameLogic::Update(music, sequence, step_sec, game);
+
+    const int bar_index = music.GetBarIndex();
+    if (bar_index != m_last_bar)
+    {
+        GameLogic::OnBar(music, game, follow_mode);
+        m_last_bar = bar_index;
+    }
+
+    ++m_step_index;
+}
+
+void GameSimulation::FinishRecording(const GameState& game)
+{
+    if (!m_recording) return;
+
+    m_recording->step_count = m_step_index;
+    m_recording->score = game.gameplay.score;
+    m_recording->stability = game.gameplay.stability;
+}
+
+// the HUD writes these from the render side, so they are inputs to the run like presses
+void GameSimulation::RecordHUDState(const GameState& game)
+{
+    if (m_hud_recorded && game.hud.hud_mode == m_recorded_hud_mode && game.hud.active_lanes_mask == m_recorded_lanes_mask) return;
+
+    m_recording->hud_changes.push_back({m_step_index, game.hud.hud_mode, game.hud.active_lanes_mask});
+    m_recorded_hud_mode = game.hud.hud_mode;
+    m_recorded_lanes_mask = game.hud.active_lanes_mask;
+    m_hud_recorded = true;
+}
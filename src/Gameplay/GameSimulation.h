@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include "Gameplay/GameState.h"
+#include "Gameplay/Lanes.h"
+#include "Gameplay/Replay.h"
+#include "Audio/Music/Events/EventSequence.h"
+#include "Transport/MusicTransport.h"
+#include "Targets/TimingTargetMode.h"
+
+/////////////////////
+// Game Simulation //
+/////////////////////////////////////////////////////////////
+// Fixed-step driver around GameLogic. Each step advances  //
+// the transport, applies the actions that fall inside it, //
+// updates the game and fires OnBar. A run is then a pure  //
+// function of the sequence, the step size and the actions //
+// so it replays bit-for-bit at any render rate.           //
+/////////////////////////////////////////////////////////////
+class GameSimulation
+{
+public:
+    // a lane press, placed on the transport timeline
+    struct Action
+    {
+        InputLane lane = InputLane::Up;
+        double transport_seconds = 0.0;
+    };
+
+    static constexpr size_t max_queued_actions = 256;
+
+    void Reset();
+
+    // actions may be queued ahead of the simulation; they wait for their step
+    bool QueueAction(InputLane lane, double transport_seconds);
+
+    void Step(
+        float step_sec,
+        MusicTransport& music,
+        const EventSequence& sequence,
+        Rhythm::TimingTargetMode follow_mode,
+        GameState& game);
+
+    size_t GetQueuedActionCount() const { return m_action_count; }
+
+    // steps taken since Reset
+    uint64_t GetStepIndex() const { return m_step_index; }
+
+    // while set, applied actions and HUD changes are appended to the replay
+    // (the pointer survives Reset; pass nullptr to stop)
+    void SetRecording(Replay* replay) { m_recording = replay; }
+
+    // stamps the step count and final score onto the recording
+    void FinishRecording(const GameState& game);
+
+private:
+    std::array<Action, max_queued_actions> m_actions{};
+    size_t m_action_count = 0;
+    int m_last_bar = -1;
+    uint64_t m_step_index = 0;
+
+    Replay* m_recording = nullptr;
+    bool m_hud_recorded = false;
+    HUDMode m_recorded_hud_mode = HUDMode::SinglePlayer;
+    uint8_t m_recorded_lanes_mask = 0;
+
+    void RecordHUDState(const GameState& game);
+};
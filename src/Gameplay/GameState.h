@@ -4,11 +4,12 @@
 #include <cmath>
 #include <cstdint>
 #include <string>
-#include <unordered_set>
 #include "Gameplay/NotePool.h"
 #include "Gameplay/RunResults.h"
 #include "Targets/TimingTargetMode.h"
+#include "Targets/TimingTargets.h"
 #include "Math/MathUtils.h"
+#include "Util/BeatBucketWindow.h"
 #include "Gameplay/HUDMode.h"
 
 ////////////////
@@ -112,11 +113,15 @@ struct GameplayState
 
     TimingPolicy timing_policy;
 
+    // per-mode target beats for the current sequence, built once
+    Rhythm::TimingTargetIndex target_index;
+
     // active notes
     GameplayPool::NotePool note_pool;
 
     // bucket to prevent duplicate spawns across overlapping scans
-    std::unordered_set<uint32_t> spawned_beat_buckets;
+    // (16 beats at 1024 buckets per beat, trailing the current beat by 8)
+    Rhythm::BeatBucketWindow<16 * 1024> spawned_beat_buckets;
     float last_spawned_beat = -INFINITY;
 
     // active lanes mask (up|right|down|left)
@@ -4,7 +4,8 @@ enum class HUDMode
 {
     SinglePlayer,
     TwoPlayer,
-    DebugRoll
+    DebugRoll,
+    Profiler
 };
 
-constexpr int NumHudModes = 3;
+constexpr int NumHudModes = 4;
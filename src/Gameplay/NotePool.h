@@ -1,9 +1,10 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 
+#include <utility>
 #include <vector>
-#include <algorithm>
 #include "Audio/Music/Orchestration/NoteSpec.h"
 #include "Gameplay/Lanes.h"
 #include "Math/MathUtils.h"
@@ -17,13 +18,42 @@
 ///////////////////////////////////////////////////
 namespace GameplayPool
 {
+    //////////////
+    // Note Ids //
+    ///////////////////////////////////////////////////////////
+    // low 16 bits are the slot, high 16 bits its generation //
+    // so an id goes stale as soon as its note is removed    //
+    ///////////////////////////////////////////////////////////
+    using NoteId = uint32_t;
+    constexpr NoteId InvalidNoteId = 0;
+
+    /////////////////
+    // Note Motion //
+    ///////////////////////////////////////////////////////////
+    // Analytic derives distance from the beat at draw time, //
+    // so notes stay locked to the music through hitches.    //
+    // Integrated steps distance by speed * dt every frame.  //
+    ///////////////////////////////////////////////////////////
+    enum class NoteMotionMode
+    {
+        Analytic,
+        Integrated
+    };
+
+    enum NoteFlags : uint8_t
+    {
+        NoteFlagConsumed = 1 << 0,
+        NoteFlagMissRegistered = 1 << 1,
+    };
+
     ////////////////////
     // Note Structure //
     ////////////////////
+    // snapshot of a single note, assembled from the pool columns
     struct Note
     {
-        uint32_t id = 0;
-  
+        NoteId id = InvalidNoteId;
+
         // note data
         float beat = 0.0f;
         InputLane lane = InputLane::Up;
@@ -33,76 +63,419 @@ namespace GameplayPool
         // motion data
         float distance_px = 0.0f;
         float pixels_per_second = 0.0f;
+        float pixels_per_beat = 0.0f;
 
         // life data
         bool consumed = false;
         bool miss_registered = false;
     };
 
-    
+
     ///////////////
     // Note Pool //
-    ///////////////
+    /////////////////////////////////////////////////////////////
+    // Fixed-capacity slot map. Live notes are packed densely  //
+    // in structure-of-arrays columns; removal swaps the last  //
+    // note into the hole, so indices are only valid until the //
+    // next spawn or cull. Use NoteId for anything longer.     //
+    /////////////////////////////////////////////////////////////
     class NotePool
     {
     public:
         static constexpr float max_step_seconds = 0.1f;
+        static constexpr size_t max_notes = 8192;
+        static constexpr size_t invalid_index = static_cast<size_t>(-1);
+
+        NotePool()
+        {
+            // every column is sized once; spawning and culling never allocate
+            m_ids.resize(max_notes, InvalidNoteId);
+            m_beat.resize(max_notes, 0.0f);
+            m_lane.resize(max_notes, 0);
+            m_voice.resize(max_notes, 0);
+            m_size.resize(max_notes, 0.0f);
+            m_distance_px.resize(max_notes, 0.0f);
+            m_pixels_per_second.resize(max_notes, 0.0f);
+            m_pixels_per_beat.resize(max_notes, 0.0f);
+            m_spawn_distance_px.resize(max_notes, 0.0f);
+            m_flags.resize(max_notes, 0);
+
+            m_slot_dense_index.resize(max_notes, 0);
+            m_slot_generation.resize(max_notes, 1);
+            m_free_slots.resize(max_notes, 0);
+
+            for (auto& queue : m_lane_queues) queue.ids.resize(max_notes, InvalidNoteId);
+            for (auto& queue : m_draw_queues) queue.ids.resize(max_notes, InvalidNoteId);
+
+            ResetFreeList();
+        }
 
         void Clear()
         {
-            m_notes.clear();
+            // retire every live id before recycling the slots
+            for (size_t note_index = 0; note_index < m_count; ++note_index)
+            {
+                RetireSlot(GetSlot(m_ids[note_index]));
+            }
+
+            m_count = 0;
+            ResetFreeList();
+
+            for (auto& queue : m_lane_queues) queue.Clear();
+            for (auto& queue : m_draw_queues) queue.Clear();
         }
 
         // spawn a new entity with pre-computed motion parameters
-        void SpawnNote(const float beat, const InputLane lane, const VoiceType voice, const float magnitude, const float initial_distance_px, const float px_per_second)
+        NoteId SpawnNote(const float beat, const InputLane lane, const VoiceType voice, const float magnitude, const float initial_distance_px, const float px_per_second, const float px_per_beat)
         {
-            Note note{};
-            note.beat = beat;
-            note.lane = lane;
-            note.voice = voice;
-            note.size = magnitude;
-            note.distance_px = initial_distance_px;
-            note.pixels_per_second = px_per_second;
-            note.consumed = false;
-            note.id = static_cast<uint32_t>(m_notes.size()) + 1;
+            if (m_free_count == 0) return InvalidNoteId;
+
+            const uint32_t slot = m_free_slots[--m_free_count];
+            const NoteId id = MakeId(slot, m_slot_generation[slot]);
+            const size_t note_index = m_count++;
+
+            m_slot_dense_index[slot] = static_cast<uint32_t>(note_index);
 
-            m_notes.push_back(note);
+            m_ids[note_index] = id;
+            m_beat[note_index] = beat;
+            m_lane[note_index] = static_cast<uint8_t>(lane);
+            m_voice[note_index] = static_cast<uint8_t>(voice);
+            m_size[note_index] = magnitude;
+            m_distance_px[note_index] = initial_distance_px;
+            m_pixels_per_second[note_index] = px_per_second;
+            m_pixels_per_beat[note_index] = px_per_beat;
+            m_spawn_distance_px[note_index] = initial_distance_px;
+            m_flags[note_index] = 0;
+
+            PushLaneQueue(m_lane_queues[GetLaneIndex(lane)], id, beat);
+            PushLaneQueue(m_draw_queues[GetLaneIndex(lane)], id, beat);
+
+            return id;
         }
 
+        // switch modes between runs; distances are not carried across
+        void SetMotionMode(const NoteMotionMode mode) { m_motion_mode = mode; }
+        NoteMotionMode GetMotionMode() const { return m_motion_mode; }
+
         // update motion for all non-consumed entities
         void StepMotion(float dt_sec, const float minimum_distance)
         {
+            m_minimum_distance_px = minimum_distance;
+
+            // analytic distances are computed when read, nothing to step
+            if (m_motion_mode == NoteMotionMode::Analytic) return;
+
             dt_sec = ClampFloat(dt_sec, 0.0f, max_step_seconds);
 
-            for (auto& note : m_notes)
-            {
-                if (note.consumed) continue;
+            // branch-free over flat columns so the compiler can vectorize it
+            float* distance = m_distance_px.data();
+            const float* speed = m_pixels_per_second.data();
+            const uint8_t* flags = m_flags.data();
+            const size_t count = m_count;
 
-                note.distance_px -= note.pixels_per_second * dt_sec;
-                if (note.distance_px < minimum_distance) note.distance_px = minimum_distance;
+            for (size_t note_index = 0; note_index < count; ++note_index)
+            {
+                const float moving = (flags[note_index] & NoteFlagConsumed) ? 0.0f : 1.0f;
+                const float next_distance = distance[note_index] - speed[note_index] * dt_sec * moving;
+                distance[note_index] = (next_distance < minimum_distance) ? minimum_distance : next_distance;
             }
         }
 
         // remove consumed and old entities
         void CullByBeat(const float current_beat, const float older_than_beats)
         {
-            auto iterator = m_notes.begin();
-            while (iterator != m_notes.end())
+            const float oldest_beat = current_beat - older_than_beats;
+
+            size_t note_index = 0;
+            while (note_index < m_count)
             {
-                const bool dead_note = iterator->consumed;
-                const bool old_note = (iterator->beat < current_beat - older_than_beats);
+                const bool dead_note = (m_flags[note_index] & NoteFlagConsumed) != 0;
+                const bool old_note = (m_beat[note_index] < oldest_beat);
 
-                if (dead_note || old_note) iterator = m_notes.erase(iterator);
-                else ++iterator;
+                // the swapped-in note lands on this index, so re-check it
+                if (dead_note || old_note) RemoveAt(note_index);
+                else ++note_index;
             }
         }
 
-        size_t Count() const { return m_notes.size(); }
+        // remove a single entity, O(1)
+        void Remove(const NoteId id)
+        {
+            const size_t note_index = GetIndex(id);
+            if (note_index != invalid_index) RemoveAt(note_index);
+        }
+
+        size_t Count() const { return m_count; }
+        size_t Capacity() const { return max_notes; }
+
+        // handle lookup
+        bool IsAlive(const NoteId id) const { return GetIndex(id) != invalid_index; }
+
+        size_t GetIndex(const NoteId id) const
+        {
+            if (id == InvalidNoteId) return invalid_index;
+
+            const uint32_t slot = GetSlot(id);
+            if (slot >= max_notes || m_slot_generation[slot] != GetGeneration(id)) return invalid_index;
+            return m_slot_dense_index[slot];
+        }
+
+        // dense column access
+        NoteId GetId(const size_t note_index) const { return m_ids[note_index]; }
+        float GetBeat(const size_t note_index) const { return m_beat[note_index]; }
+        InputLane GetLane(const size_t note_index) const { return static_cast<InputLane>(m_lane[note_index]); }
+        VoiceType GetVoice(const size_t note_index) const { return static_cast<VoiceType>(m_voice[note_index]); }
+        float GetSize(const size_t note_index) const { return m_size[note_index]; }
+        float GetPixelsPerBeat(const size_t note_index) const { return m_pixels_per_beat[note_index]; }
+        float GetPixelsPerSecond(const size_t note_index) const { return m_pixels_per_second[note_index]; }
+        // distance from the target at the given beat
+        float GetDistancePx(const size_t note_index, const float current_beat) const
+        {
+            if (m_motion_mode == NoteMotionMode::Integrated) return m_distance_px[note_index];
+
+            // consumed notes are culled on the next update, so they are not frozen here
+            const float beats_until_target = m_beat[note_index] - current_beat;
+            const float distance = m_minimum_distance_px + beats_until_target * m_pixels_per_beat[note_index];
+            return ClampFloat(distance, m_minimum_distance_px, m_spawn_distance_px[note_index]);
+        }
+
+        bool IsConsumed(const size_t note_index) const { return (m_flags[note_index] & NoteFlagConsumed) != 0; }
+        bool IsMissRegistered(const size_t note_index) const { return (m_flags[note_index] & NoteFlagMissRegistered) != 0; }
+
+        void MarkConsumed(const size_t note_index) { m_flags[note_index] |= NoteFlagConsumed; }
+        void MarkMissRegistered(const size_t note_index) { m_flags[note_index] |= NoteFlagMissRegistered; }
+
+        // per-lane queues, ordered by beat with the earliest note at the front
+        size_t GetLaneQueueCount(const InputLane lane) const { return m_lane_queues[GetLaneIndex(lane)].count; }
+        NoteId GetLaneQueueId(const InputLane lane, const size_t offset) const { return m_lane_queues[GetLaneIndex(lane)].At(offset); }
+        void PopLaneQueueFront(const InputLane lane) { m_lane_queues[GetLaneIndex(lane)].PopFront(); }
+
+        // drop removed or consumed notes from the front of a lane queue
+        void TrimLaneQueue(const InputLane lane)
+        {
+            LaneQueue& queue = m_lane_queues[GetLaneIndex(lane)];
+            while (queue.count > 0)
+            {
+                const size_t note_index = GetIndex(queue.At(0));
+                if (note_index != invalid_index && !IsConsumed(note_index)) break;
+                queue.PopFront();
+            }
+        }
+
+        // dense indices of every live note, farthest first (nearer notes draw over farther ones).
+        // Each lane's draw queue is beat-ordered, which for notes sharing an approach speed is
+        // distance order as well, so this merges four sorted runs rather than sorting the pool.
+        void CollectDrawOrder(const float current_beat, std::vector<size_t>& draw_order)
+        {
+            draw_order.clear();
+
+            std::array<size_t, InputLaneCount> cursors{};
+            std::array<size_t, InputLaneCount> next_indices{};
+            for (int lane_index = 0; lane_index < InputLaneCount; ++lane_index)
+            {
+                LaneQueue& queue = m_draw_queues[lane_index];
+                while (queue.count > 0 && GetIndex(queue.At(0)) == invalid_index) queue.PopFront();
+
+                // walk each lane from its latest beat, the farthest note, toward the front
+                cursors[lane_index] = queue.count;
+                next_indices[lane_index] = NextDrawIndex(queue, cursors[lane_index]);
+            }
+
+            while (true)
+            {
+                int best_lane = -1;
+                float best_distance = 0.0f;
+                for (int lane_index = 0; lane_index < InputLaneCount; ++lane_index)
+                {
+                    const size_t note_index = next_indices[lane_index];
+                    if (note_index == invalid_index) continue;
 
-        Note& GetNote(const size_t note_index) { return m_notes[note_index]; }
-        const Note& GetNote(const size_t note_index) const { return m_notes[note_index]; }
+                    // same tie-break the HUD sorted with: near-equal distances draw earlier beats first
+                    const float distance = GetDistancePx(note_index, current_beat);
+                    const bool farther = best_lane < 0 ||
+                                         ((fabsf(distance - best_distance) > 0.01f) ? distance > best_distance
+                                                                                     : m_beat[note_index] < m_beat[next_indices[best_lane]]);
+                    if (!farther) continue;
+
+                    best_lane = lane_index;
+                    best_distance = distance;
+                }
+
+                if (best_lane < 0) break;
+
+                draw_order.push_back(next_indices[best_lane]);
+                next_indices[best_lane] = NextDrawIndex(m_draw_queues[best_lane], cursors[best_lane]);
+            }
+        }
+
+        Note GetNote(const size_t note_index, const float current_beat) const
+        {
+            Note note{};
+            note.id = m_ids[note_index];
+            note.beat = m_beat[note_index];
+            note.lane = GetLane(note_index);
+            note.voice = GetVoice(note_index);
+            note.size = m_size[note_index];
+            note.distance_px = GetDistancePx(note_index, current_beat);
+            note.pixels_per_second = m_pixels_per_second[note_index];
+            note.pixels_per_beat = m_pixels_per_beat[note_index];
+            note.consumed = IsConsumed(note_index);
+            note.miss_registered = IsMissRegistered(note_index);
+            return note;
+        }
 
     private:
-        std::vector<Note> m_notes;
+        ////////////////
+        // Lane Queue //
+        ///////////////////////////////////////////////////////
+        // ring buffer of ids on one lane. Removed notes are //
+        // left in place and skipped once they reach the     //
+        // front, so culling never has to touch the queues.  //
+        ///////////////////////////////////////////////////////
+        struct LaneQueue
+        {
+            static constexpr size_t mask = max_notes - 1;
+            static_assert((max_notes & mask) == 0, "lane queue capacity must be a power of two");
+
+            std::vector<NoteId> ids;
+            size_t head = 0;
+            size_t count = 0;
+
+            NoteId& At(const size_t offset) { return ids[(head + offset) & mask]; }
+            NoteId At(const size_t offset) const { return ids[(head + offset) & mask]; }
+
+            void PopFront()
+            {
+                head = (head + 1) & mask;
+                --count;
+            }
+
+            void Clear()
+            {
+                head = 0;
+                count = 0;
+            }
+        };
+
+        void PushLaneQueue(LaneQueue& queue, const NoteId id, const float beat)
+        {
+            // a full queue always holds stale ids, since the pool had a free slot
+            if (queue.count == max_notes) CompactLaneQueue(queue);
+
+            size_t offset = queue.count++;
+            queue.At(offset) = id;
+
+            // spawns arrive in beat order, so this rarely moves more than once
+            while (offset > 0)
+            {
+                NoteId& previous_id = queue.At(offset - 1);
+                const size_t previous_index = GetIndex(previous_id);
+                if (previous_index != invalid_index && m_beat[previous_index] <= beat) break;
+
+                std::swap(previous_id, queue.At(offset));
+                --offset;
+            }
+        }
+
+        void CompactLaneQueue(LaneQueue& queue)
+        {
+            size_t kept_count = 0;
+            for (size_t offset = 0; offset < queue.count; ++offset)
+            {
+                const NoteId id = queue.At(offset);
+                if (GetIndex(id) != invalid_index) queue.At(kept_count++) = id;
+            }
+            queue.count = kept_count;
+        }
+
+        // steps a draw cursor back to the next live note; removed notes are skipped
+        size_t NextDrawIndex(const LaneQueue& queue, size_t& cursor) const
+        {
+            while (cursor > 0)
+            {
+                const size_t note_index = GetIndex(queue.At(--cursor));
+                if (note_index != invalid_index) return note_index;
+            }
+            return invalid_index;
+        }
+
+        static uint32_t GetSlot(const NoteId id) { return id & 0xFFFFu; }
+        static uint16_t GetGeneration(const NoteId id) { return static_cast<uint16_t>(id >> 16); }
+        static NoteId MakeId(const uint32_t slot, const uint16_t generation) { return (static_cast<NoteId>(generation) << 16) | slot; }
+
+        void RetireSlot(const uint32_t slot)
+        {
+            // generation 0 is reserved so a live id is never InvalidNoteId
+            uint16_t& generation = m_slot_generation[slot];
+            generation = static_cast<uint16_t>(generation + 1);
+            if (generation == 0) generation = 1;
+        }
+
+        void ResetFreeList()
+        {
+            // hand out low slots first
+            m_free_count = max_notes;
+            for (size_t free_index = 0; free_index < max_notes; ++free_index)
+            {
+                m_free_slots[free_index] = static_cast<uint32_t>(max_notes - 1 - free_index);
+            }
+        }
+
+        void RemoveAt(const size_t note_index)
+        {
+            const uint32_t slot = GetSlot(m_ids[note_index]);
+            const size_t last_index = m_count - 1;
+
+            // move the last note into the hole
+            if (note_index != last_index)
+            {
+                m_ids[note_index] = m_ids[last_index];
+                m_beat[note_index] = m_beat[last_index];
+                m_lane[note_index] = m_lane[last_index];
+                m_voice[note_index] = m_voice[last_index];
+                m_size[note_index] = m_size[last_index];
+                m_distance_px[note_index] = m_distance_px[last_index];
+                m_pixels_per_second[note_index] = m_pixels_per_second[last_index];
+                m_pixels_per_beat[note_index] = m_pixels_per_beat[last_index];
+                m_spawn_distance_px[note_index] = m_spawn_distance_px[last_index];
+                m_flags[note_index] = m_flags[last_index];
+
+                m_slot_dense_index[GetSlot(m_ids[note_index])] = static_cast<uint32_t>(note_index);
+            }
+
+            RetireSlot(slot);
+            m_free_slots[m_free_count++] = slot;
+            m_count = last_index;
+        }
+
+        // dense columns
+        std::vector<NoteId> m_ids;
+        std::vector<float> m_beat;
+        std::vector<uint8_t> m_lane;
+        std::vector<uint8_t> m_voice;
+        std::vector<float> m_size;
+        std::vector<float> m_distance_px;
+        std::vector<float> m_pixels_per_second;
+        std::vector<float> m_pixels_per_beat;
+        std::vector<float> m_spawn_distance_px;
+        std::vector<uint8_t> m_flags;
+        size_t m_count = 0;
+
+        // motion
+        NoteMotionMode m_motion_mode = NoteMotionMode::Analytic;
+        float m_minimum_distance_px = 0.0f;
+
+        // slot map
+        std::vector<uint32_t> m_slot_dense_index;
+        std::vector<uint16_t> m_slot_generation;
+        std::vector<uint32_t> m_free_slots;
+        size_t m_free_count = 0;
+
+        // lane queues
+        std::array<LaneQueue, InputLaneCount> m_lane_queues;
+
+        // the same per-lane order, but consumed notes stay until they are removed,
+        // since they are still drawn
+        std::array<LaneQueue, InputLaneCount> m_draw_queues;
     };
 }
@@ -0,0 +1,179 @@
+#include "Gameplay/Replay.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    constexpr const char* replay_header = "PRELUDE_REPLAY";
+    constexpr int replay_version = 1;
+
+    // hud changes are rare; a run normally has one or two
+    constexpr size_t reserved_hud_changes = 64;
+
+    bool SameResults(const RunResults& left, const RunResults& right)
+    {
+        return left.perfect == right.perfect &&
+               left.good == right.good &&
+               left.late == right.late &&
+               left.missed == right.missed;
+    }
+
+    void WriteResults(FILE* file, const char* label, const RunResults& results)
+    {
+        std::fprintf(file, "%s %d %d %d %d\n", label, results.perfect, results.good, results.late, results.missed);
+    }
+
+    bool ReadResults(FILE* file, const char* label, RunResults& results)
+    {
+        char read_label[16] = {};
+        if (std::fscanf(file, "%15s %d %d %d %d", read_label, &results.perfect, &results.good, &results.late, &results.missed) != 5) return false;
+        return std::strcmp(read_label, label) == 0;
+    }
+}
+
+void Replay::Clear()
+{
+    song_id.clear();
+    actions.clear();
+    hud_changes.clear();
+    step_count = 0;
+    score = ScoreState{};
+    stability = 1.0f;
+}
+
+void Replay::Reserve(const size_t action_count)
+{
+    actions.reserve(action_count);
+    hud_changes.reserve(reserved_hud_changes);
+}
+
+bool Replay::SaveToFile(const std::string& path) const
+{
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) return false;
+
+    // %.17g and %.9g round-trip doubles and floats exactly
+    std::fprintf(file, "%s %d\n", replay_header, replay_version);
+    std::fprintf(file, "song %s\n", song_id.c_str());
+    std::fprintf(file, "follow %d\n", static_cast<int>(follow_mode));
+    std::fprintf(file, "step %.9g\n", static_cast<double>(step_sec));
+    std::fprintf(file, "latency %.9g\n", static_cast<double>(audio_latency_seconds));
+    std::fprintf(file, "cull %.9g\n", static_cast<double>(cull_notes_older_than_beats));
+    std::fprintf(file, "punish %d\n", punish_enabled ? 1 : 0);
+
+    std::fprintf(file, "hud %zu\n", hud_changes.size());
+    for (const HUDChange& change : hud_changes)
+    {
+        std::fprintf(file, "%llu %d %u\n",
+                     static_cast<unsigned long long>(change.step_index),
+                     static_cast<int>(change.hud_mode),
+                     static_cast<unsigned>(change.active_lanes_mask));
+    }
+
+    std::fprintf(file, "actions %zu\n", actions.size());
+    for (const Action& action : actions)
+    {
+        std::fprintf(file, "%llu %d %.17g\n",
+                     static_cast<unsigned long long>(action.step_index),
+                     GetLaneIndex(action.lane),
+                     action.transport_seconds);
+    }
+
+    std::fprintf(file, "steps %llu\n", static_cast<unsigned long long>(step_count));
+    std::fprintf(file, "stability %.9g\n", static_cast<double>(stability));
+    WriteResults(file, "total", score.totals);
+    for (const RunResults& lane_score : score.lane_scores) WriteResults(file, "lane", lane_score);
+
+    return std::fclose(file) == 0;
+}
+
+bool Replay::LoadFromFile(const std::string& path)
+{
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (!file) return false;
+
+    Clear();
+
+    char header[32] = {};
+    char song[64] = {};
+    int version = 0;
+    int follow = 0;
+    int punish = 0;
+    size_t hud_count = 0;
+    size_t action_count = 0;
+    unsigned long long steps = 0;
+    double step = 0.0;
+    double latency = 0.0;
+    double cull = 0.0;
+    double final_stability = 0.0;
+
+    bool loaded =
+        std::fscanf(file, "%31s %d", header, &version) == 2 &&
+        std::strcmp(header, replay_header) == 0 && version == replay_version &&
+        std::fscanf(file, " song %63s", song) == 1 &&
+        std::fscanf(file, " follow %d", &follow) == 1 &&
+        std::fscanf(file, " step %lf", &step) == 1 &&
+        std::fscanf(file, " latency %lf", &latency) == 1 &&
+        std::fscanf(file, " cull %lf", &cull) == 1 &&
+        std::fscanf(file, " punish %d", &punish) == 1 &&
+        std::fscanf(file, " hud %zu", &hud_count) == 1;
+
+    if (loaded)
+    {
+        song_id = song;
+        follow_mode = static_cast<Rhythm::TimingTargetMode>(follow);
+        step_sec = static_cast<float>(step);
+        audio_latency_seconds = static_cast<float>(latency);
+        cull_notes_older_than_beats = static_cast<float>(cull);
+        punish_enabled = punish != 0;
+        loaded = step_sec > 0.0f && follow >= 0 && follow < Rhythm::NumTimingTargetModes;
+    }
+
+    for (size_t change_index = 0; loaded && change_index < hud_count; ++change_index)
+    {
+        unsigned long long step_index = 0;
+        int mode = 0;
+        unsigned mask = 0;
+        loaded = std::fscanf(file, "%llu %d %u", &step_index, &mode, &mask) == 3 && mode >= 0 && mode < NumHudModes;
+        if (loaded) hud_changes.push_back({step_index, static_cast<HUDMode>(mode), static_cast<uint8_t>(mask)});
+    }
+
+    loaded = loaded && std::fscanf(file, " actions %zu", &action_count) == 1;
+    if (loaded) actions.reserve(action_count);
+
+    for (size_t action_index = 0; loaded && action_index < action_count; ++action_index)
+    {
+        unsigned long long step_index = 0;
+        int lane = 0;
+        double transport_seconds = 0.0;
+        loaded = std::fscanf(file, "%llu %d %lf", &step_index, &lane, &transport_seconds) == 3 && lane >= 0 && lane < InputLaneCount;
+        if (loaded) actions.push_back({step_index, static_cast<InputLane>(lane), transport_seconds});
+    }
+
+    loaded = loaded &&
+        std::fscanf(file, " steps %llu", &steps) == 1 &&
+        std::fscanf(file, " stability %lf", &final_stability) == 1 &&
+        ReadResults(file, "total", score.totals);
+
+    for (RunResults& lane_score : score.lane_scores)
+    {
+        loaded = loaded && ReadResults(file, "lane", lane_score);
+    }
+
+    step_count = steps;
+    stability = static_cast<float>(final_stability);
+
+    std::fclose(file);
+    return loaded;
+}
+
+bool SameScore(const ScoreState& left, const ScoreState& right)
+{
+    if (!SameResults(left.totals, right.totals)) return false;
+    for (size_t lane_index = 0; lane_index < left.lane_scores.size(); ++lane_index)
+    {
+        if (!SameResults(left.lane_scores[lane_index], right.lane_scores[lane_index])) return false;
+    }
+    return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Gameplay/GameState.h"
+#include "Gameplay/HUDMode.h"
+#include "Gameplay/Lanes.h"
+#include "Targets/TimingTargetMode.h"
+
+////////////
+// Replay //
+/////////////////////////////////////////////////////////////
+// A recorded run: the song and settings it started from,  //
+// every judged press and HUD change, each tagged with the //
+// fixed step that applied it, and the score it ended on.  //
+// Fed back through GameSimulation it reproduces the run   //
+// exactly, with no clock, audio or rendering involved.    //
+/////////////////////////////////////////////////////////////
+struct Replay
+{
+    struct Action
+    {
+        uint64_t step_index = 0;
+        InputLane lane = InputLane::Up;
+        double transport_seconds = 0.0;
+    };
+
+    // the HUD feeds its lane mask and punish mode back into gameplay
+    struct HUDChange
+    {
+        uint64_t step_index = 0;
+        HUDMode hud_mode = HUDMode::SinglePlayer;
+        uint8_t active_lanes_mask = 0x0F;
+    };
+
+    // settings the run started from
+    std::string song_id;
+    Rhythm::TimingTargetMode follow_mode = Rhythm::TimingTargetMode::Kick;
+    float step_sec = 0.001f;
+    float audio_latency_seconds = 0.030f;
+    float cull_notes_older_than_beats = 1.0f;
+    bool punish_enabled = true;
+
+    std::vector<Action> actions;
+    std::vector<HUDChange> hud_changes;
+
+    // where the recorded run ended
+    uint64_t step_count = 0;
+    ScoreState score{};
+    float stability = 1.0f;
+
+    // keeps capacity so a recording can be reserved once up front
+    void Clear();
+    void Reserve(size_t action_count);
+
+    // plain text, one record per line
+    bool SaveToFile(const std::string& path) const;
+    bool LoadFromFile(const std::string& path);
+};
+
+bool SameScore(const ScoreState& left, const ScoreState& right);
@@ -0,0 +1,89 @@
+#include "Gameplay/ReplayRunner.h"
+#include "Gameplay/SongCatalog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+bool ReplayRunner::Load(const Replay& replay)
+{
+    m_replay = nullptr;
+
+    MixSettings mix{};
+    if (!MakeSongById(replay.song_id, mix, m_sequence)) return false;
+
+    m_replay = &replay;
+    m_step_ns.reserve(static_cast<size_t>(replay.step_count));
+    return true;
+}
+
+ReplayRunner::Result ReplayRunner::Run()
+{
+    Result result;
+    if (!m_replay) return result;
+    const Replay& replay = *m_replay;
+
+    // the same starting state GameplayScene builds
+    m_game = GameState{};
+    m_game.gameplay.stability = 1.0f;
+    m_game.gameplay.punish_enabled = replay.punish_enabled;
+    m_game.gameplay.cull_notes_older_than_beats = replay.cull_notes_older_than_beats;
+    m_game.gameplay.difficulty = replay.song_id;
+
+    m_music = MusicTransport{};
+    m_music.bpm = m_sequence.bpm;
+    m_music.beats_per_bar = m_sequence.beats_per_bar;
+    m_music.audio_latency_seconds = replay.audio_latency_seconds;
+    m_music.Reset();
+
+    m_sim.Reset();
+    m_step_ns.clear();
+
+    size_t next_action = 0;
+    size_t next_hud_change = 0;
+
+    const auto run_start = std::chrono::steady_clock::now();
+    for (uint64_t step_index = 0; step_index < replay.step_count; ++step_index)
+    {
+        const auto step_start = std::chrono::steady_clock::now();
+
+        while (next_hud_change < replay.hud_changes.size() && replay.hud_changes[next_hud_change].step_index <= step_index)
+        {
+            const Replay::HUDChange& change = replay.hud_changes[next_hud_change++];
+            m_game.hud.hud_mode = change.hud_mode;
+            m_game.hud.active_lanes_mask = change.active_lanes_mask;
+        }
+
+        while (next_action < replay.actions.size() && replay.actions[next_action].step_index <= step_index)
+        {
+            const Replay::Action& action = replay.actions[next_action++];
+            (void)m_sim.QueueAction(action.lane, action.transport_seconds);
+        }
+
+        m_sim.Step(replay.step_sec, m_music, m_sequence, replay.follow_mode, m_game);
+
+        const auto step_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - step_start).count();
+        m_step_ns.push_back(static_cast<uint32_t>(step_ns));
+    }
+    const auto run_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - run_start).count();
+
+    result.steps = m_sim.GetStepIndex();
+    result.score = m_game.gameplay.score;
+    result.stability = m_game.gameplay.stability;
+    result.matched = result.steps == replay.step_count &&
+                     SameScore(result.score, replay.score) &&
+                     result.stability == replay.stability;
+
+    result.run_ms = static_cast<double>(run_ns) / 1000000.0;
+    if (!m_step_ns.empty())
+    {
+        result.mean_step_us = static_cast<double>(run_ns) / 1000.0 / static_cast<double>(m_step_ns.size());
+
+        const size_t p99_index = (m_step_ns.size() * 99) / 100;
+        std::nth_element(m_step_ns.begin(), m_step_ns.begin() + static_cast<std::ptrdiff_t>(p99_index), m_step_ns.end());
+        result.p99_step_us = static_cast<double>(m_step_ns[p99_index]) / 1000.0;
+        result.max_step_us = static_cast<double>(*std::max_element(m_step_ns.begin() + static_cast<std::ptrdiff_t>(p99_index), m_step_ns.end())) / 1000.0;
+    }
+
+    return result;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Gameplay/GameSimulation.h"
+#include "Gameplay/GameState.h"
+#include "Gameplay/Replay.h"
+#include "Audio/Music/Events/EventSequence.h"
+#include "Transport/MusicTransport.h"
+
+///////////////////
+// Replay Runner //
+/////////////////////////////////////////////////////////////
+// Plays a Replay back through GameSimulation as fast as   //
+// the CPU allows: each recorded press and HUD change is   //
+// handed over just before the step that applied it, so    //
+// the run is reproduced step for step. Reports whether    //
+// the score matched and what each step cost.              //
+/////////////////////////////////////////////////////////////
+class ReplayRunner
+{
+public:
+    struct Result
+    {
+        bool matched = false;
+        uint64_t steps = 0;
+        ScoreState score{};
+        float stability = 0.0f;
+
+        // wall time of the whole run, and per fixed step
+        double run_ms = 0.0;
+        double mean_step_us = 0.0;
+        double p99_step_us = 0.0;
+        double max_step_us = 0.0;
+    };
+
+    // rebuilds the replay's song from the catalog; false if the ID is unknown
+    bool Load(const Replay& replay);
+
+    // replays the loaded run once from a fresh GameState
+    Result Run();
+
+    const GameState& GetGameState() const { return m_game; }
+
+private:
+    const Replay* m_replay = nullptr;
+    EventSequence m_sequence;
+
+    GameSimulation m_sim;
+    MusicTransport m_music;
+    GameState m_game{};
+
+    // per-step timings, kept between runs
+    std::vector<uint32_t> m_step_ns;
+};
@@ -0,0 +1,41 @@
+#include "Gameplay/SongCatalog.h"
+#include "Audio/Music/Orchestration/GameplaySongs.h"
+#include "Audio/Music/Orchestration/TestSequences.h"
+
+bool MakeSongById(const std::string& song_id, MixSettings& mix, EventSequence& sequence)
+{
+    if (song_id == "Easy")
+    {
+        sequence = MakeSong_Easy(mix);
+        return true;
+    }
+    if (song_id == "Medium")
+    {
+        sequence = MakeSong_Medium(mix);
+        return true;
+    }
+    if (song_id == "Hard")
+    {
+        sequence = MakeSong_Hard(mix);
+        return true;
+    }
+    if (song_id == "Brutal")
+    {
+        sequence = MakeSong_Brutal(mix);
+        return true;
+    }
+    if (song_id == "Test")
+    {
+        // note density test
+        mix.lead_gain = 0.03f;
+        sequence = MakeSong_NotePoolTest(mix);
+        return true;
+    }
+    if (song_id == "CompositionAPI")
+    {
+        // tests for the composition API
+        sequence = MakeSong_CompositionAPITests(mix);
+        return true;
+    }
+    return false;
+}
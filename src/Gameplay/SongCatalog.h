@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+#include "Audio/Music/Events/EventSequence.h"
+#include "Audio/Music/Render/MixSettings.h"
+
+//////////////////
+// Song Catalog //
+/////////////////////////////////////////////////////////////
+// Maps a song ID to the sequence it builds. The gameplay  //
+// scene picks songs through here, and replays use it to   //
+// rebuild the exact sequence a recording was played on.   //
+/////////////////////////////////////////////////////////////
+
+// every song in GameplaySongs.h and TestSequences.h
+inline constexpr const char* song_catalog_ids[] = { "Easy", "Medium", "Hard", "Brutal", "Test", "CompositionAPI" };
+
+// returns false for an unknown ID
+bool MakeSongById(const std::string& song_id, MixSettings& mix, EventSequence& sequence);
@@ -1,6 +1,10 @@
 ﻿#pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include "NoteEvent.h"
 #include "Audio/Music/Render/MixSettings.h"
@@ -16,11 +20,14 @@ struct EventSequence
     float bpm = 120.0f;
     int beats_per_bar = 4;
     MixSettings mix;
+
+    // anything that edits notes directly must call MarkNotesChanged() afterwards
     std::vector<NoteEvent> notes;
 
     void SortByStart()
     {
         std::sort(notes.begin(), notes.end(), CompareNotes);
+        MarkNotesChanged();
     }
 
     static bool CompareNotes(const NoteEvent& a, const NoteEvent& b)
@@ -28,17 +35,36 @@ struct EventSequence
         return (a.start_beat != b.start_beat) ? a.start_beat < b.start_beat : a.midi_note < b.midi_note;
     }
 
-    float GetLengthBeats() const
+    // rescans the notes into the cached metadata and takes a new generation
+    void MarkNotesChanged()
     {
-        if (notes.empty()) return 0.0f;
+        m_first_beat = notes.empty() ? 0.0f : notes.front().start_beat;
+        m_length_beats = 0.0f;
+        m_voice_counts.fill(0);
 
-        float max_end = 0.0f;
         for (const auto& note : notes)
         {
-            max_end = std::max(max_end, note.start_beat + note.duration_beat);
+            m_first_beat = std::min(m_first_beat, note.start_beat);
+            m_length_beats = std::max(m_length_beats, note.start_beat + note.duration_beat);
+
+            const int voice_index = static_cast<int>(note.voice);
+            if (voice_index >= 0 && voice_index < NumVoiceTypes) ++m_voice_counts[voice_index];
         }
-        
-        return max_end;
+
+        m_generation = NextGeneration();
+    }
+
+    // unique across sequences and bumped on every note change, so a cache only has to
+    // compare this (a copy keeps its source's generation, since the notes match)
+    uint64_t GetGeneration() const { return m_generation; }
+
+    // cached by MarkNotesChanged
+    float GetLengthBeats() const { return m_length_beats; }
+    float GetFirstBeat() const { return m_first_beat; }
+    size_t GetVoiceCount(const VoiceType voice) const
+    {
+        const int voice_index = static_cast<int>(voice);
+        return (voice_index >= 0 && voice_index < NumVoiceTypes) ? m_voice_counts[voice_index] : 0;
     }
 
     float GetLengthSec() const
@@ -53,9 +79,22 @@ struct EventSequence
             note.start_sec = BeatsToSeconds(note.start_beat);
             note.duration_sec = BeatsToSeconds(note.duration_beat);
         }
+        MarkNotesChanged();
     }
 
 private:
+    // generation 0 is an empty, never-edited sequence
+    uint64_t m_generation = 0;
+    float m_first_beat = 0.0f;
+    float m_length_beats = 0.0f;
+    std::array<uint32_t, NumVoiceTypes> m_voice_counts{};
+
+    static uint64_t NextGeneration()
+    {
+        static std::atomic<uint64_t> next_generation{1};
+        return next_generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
     float BeatsToSeconds(const float beats) const
     {
         return beats * (60.0f / bpm);
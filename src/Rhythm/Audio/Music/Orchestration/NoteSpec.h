@@ -32,6 +32,8 @@ enum class VoiceType
     Chord
 };
 
+constexpr int NumVoiceTypes = 6;
+
 inline bool IsDrumVoice(const VoiceType voice)
 {
     return voice == VoiceType::Kick ||
@@ -8,6 +8,7 @@
 #include "Audio/Synth/Voices/TriangleSynth.h"
 #include "Audio/Music/DSP/BufferUtils.h"
 #include "Audio/Music/DSP/TransientUtils.h"
+#include "Util/Profiler.h"
 #include "Audio/Synth/Primitives/Oscillator.h"
 #include "Audio/Synth/Primitives/EnvelopeFilter.h"
 #include <vector>
@@ -185,6 +186,8 @@ namespace
 std::vector<float>
 EventSequenceRenderer::RenderToBuffer(const EventSequence& sequence, const RenderSettings& settings)
 {
+    PROFILE_ZONE("EventSequenceRenderer::RenderToBuffer");
+
     // compute total render duration
     const float total_len_sec = sequence.GetLengthSec() + settings.tail_seconds;
     const int total_samples = static_cast<int>(std::ceil(total_len_sec * static_cast<float>(settings.sample_rate)));
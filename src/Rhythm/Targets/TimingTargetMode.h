@@ -17,4 +17,6 @@ namespace Rhythm
         // game defaults to kick
         Kick
     };
+
+    constexpr int NumTimingTargetModes = 6;
 }
@@ -2,11 +2,31 @@
 #include "Audio/Music/Events/EventSequence.h"
 #include "Audio/Music/Orchestration/NoteSpec.h"
 
+#include <algorithm>
 #include <cmath>
 
 // figures out what notes in the EventSequence needs to have a gameplay entity attached to them
 namespace Rhythm
 {
+bool IsTargetVoice(const TimingTargetMode mode, const VoiceType voice)
+{
+    switch (mode)
+    {
+        case TimingTargetMode::Snare: return voice == VoiceType::Snare;
+        case TimingTargetMode::Kick: return voice == VoiceType::Kick;
+        case TimingTargetMode::KickAndSnare: return voice == VoiceType::Kick || voice == VoiceType::Snare;
+        case TimingTargetMode::Melody: return voice == VoiceType::Lead;
+        case TimingTargetMode::All:  return voice == VoiceType::Lead ||
+                                            voice == VoiceType::Kick ||
+                                            voice == VoiceType::Snare ||
+                                            voice == VoiceType::Hat ||
+                                            voice == VoiceType::Triangle ||
+                                            voice == VoiceType::Chord;
+        default:
+            return false;
+    }
+}
+
 void CollectTimingTargets(const EventSequence& seq, const TimingTargetMode mode, const float current_beat, const float lookahead_beats, std::vector<float>& out_targets)
 {
     out_targets.clear();
@@ -29,29 +49,118 @@ void CollectTimingTargets(const EventSequence& seq, const TimingTargetMode mode,
     }
 
     // note targets
-    auto included_voice_target = [&](const VoiceType voice)
+    for (const auto& note_event : seq.notes)
     {
-        switch (mode)
+        if (note_event.start_beat < start || note_event.start_beat > end) continue;
+        if (IsTargetVoice(mode, note_event.voice)) out_targets.push_back(note_event.start_beat);
+    }
+}
+
+/////////////////////////
+// Timing Target Index //
+/////////////////////////
+void TimingTargetIndex::Clear()
+{
+    for (auto& targets : m_targets) targets.clear();
+    m_cursors.fill(0);
+
+    m_generation = 0;
+    m_built = false;
+}
+
+bool TimingTargetIndex::IsBuiltFor(const EventSequence& seq) const
+{
+    return m_built && m_generation == seq.GetGeneration();
+}
+
+void TimingTargetIndex::EnsureBuilt(const EventSequence& seq)
+{
+    if (!IsBuiltFor(seq)) Build(seq);
+}
+
+void TimingTargetIndex::Build(const EventSequence& seq)
+{
+    Clear();
+
+    m_generation = seq.GetGeneration();
+    m_built = true;
+
+    for (int mode_index = 0; mode_index < NumTimingTargetModes; ++mode_index)
+    {
+        const TimingTargetMode mode = static_cast<TimingTargetMode>(mode_index);
+        auto& targets = m_targets[mode_index];
+
+        // barlines cover the song plus one closing bar, matching the ghost pool
+        if (mode == TimingTargetMode::Barline)
         {
-            case TimingTargetMode::Snare: return voice == VoiceType::Snare;
-            case TimingTargetMode::Kick: return voice == VoiceType::Kick;
-            case TimingTargetMode::KickAndSnare: return voice == VoiceType::Kick || voice == VoiceType::Snare;
-            case TimingTargetMode::Melody: return voice == VoiceType::Lead;
-            case TimingTargetMode::All:  return voice == VoiceType::Lead ||
-                                                voice == VoiceType::Kick ||
-                                                voice == VoiceType::Snare ||
-                                                voice == VoiceType::Hat ||
-                                                voice == VoiceType::Triangle ||
-                                                voice == VoiceType::Chord;
-            default:
-                return false;
+            const float beats_per_bar = static_cast<float>(seq.beats_per_bar);
+            const int bar_count = static_cast<int>(ceilf(seq.GetLengthBeats() / std::max(1.0f, beats_per_bar))) + 1;
+            targets.reserve(static_cast<size_t>(bar_count));
+
+            for (int bar_index = 0; bar_index < bar_count; ++bar_index)
+            {
+                targets.push_back(static_cast<float>(bar_index) * beats_per_bar);
+            }
+            continue;
         }
-    };
 
-    for (const auto& note_event : seq.notes)
+        for (const auto& note_event : seq.notes)
+        {
+            if (IsTargetVoice(mode, note_event.voice)) targets.push_back(note_event.start_beat);
+        }
+
+        // remove near-duplicate targets (chords, layered drums)
+        std::sort(targets.begin(), targets.end());
+        targets.erase(std::unique(targets.begin(), targets.end(),
+            [](const float left, const float right)
+            {
+                return fabsf(left - right) < merge_epsilon_beats;
+            }), targets.end());
+        targets.shrink_to_fit();
+    }
+}
+
+TimingTargetRange TimingTargetIndex::Query(const TimingTargetMode mode, const float current_beat, const float lookahead_beats)
+{
+    const int mode_index = static_cast<int>(mode);
+    if (mode_index < 0 || mode_index >= NumTimingTargetModes) return {};
+
+    const auto& targets = m_targets[mode_index];
+    if (targets.empty()) return {};
+
+    const float start = current_beat - lookback_beats;
+    const float end = current_beat + lookahead_beats;
+
+    const float* data = targets.data();
+    const size_t count = targets.size();
+
+    // resume from the last window start; seeks and rewinds fall back to a binary search
+    size_t cursor = std::min(m_cursors[mode_index], count);
+    const bool rewound = cursor > 0 && data[cursor - 1] >= start;
+    const bool far_ahead = cursor + max_cursor_steps < count && data[cursor + max_cursor_steps] < start;
+
+    if (rewound || far_ahead)
     {
-        if (note_event.start_beat < start || note_event.start_beat > end) continue;
-        if (included_voice_target(note_event.voice)) out_targets.push_back(note_event.start_beat);
+        cursor = static_cast<size_t>(std::lower_bound(data, data + count, start) - data);
+    }
+    else
+    {
+        while (cursor < count && data[cursor] < start) ++cursor;
     }
+    m_cursors[mode_index] = cursor;
+
+    size_t last = cursor;
+    while (last < count && data[last] <= end) ++last;
+
+    return { data + cursor, data + last };
+}
+
+const std::vector<float>& TimingTargetIndex::GetTargets(const TimingTargetMode mode) const
+{
+    static const std::vector<float> empty;
+
+    const int mode_index = static_cast<int>(mode);
+    if (mode_index < 0 || mode_index >= NumTimingTargetModes) return empty;
+    return m_targets[mode_index];
 }
 }
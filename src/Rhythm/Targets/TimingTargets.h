@@ -1,7 +1,11 @@
 #pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "Targets/TimingTargetMode.h"
+#include "Audio/Music/Orchestration/NoteSpec.h"
 
 struct EventSequence;
 
@@ -10,9 +14,58 @@ namespace Rhythm
     ////////////////////
     // Timing Targets //
     ////////////////////
+    bool IsTargetVoice(TimingTargetMode mode, VoiceType voice);
+
     void CollectTimingTargets(const EventSequence& seq,
                               TimingTargetMode mode,
                               float current_beat,
                               float lookahead_beats,
                               std::vector<float>& out_targets);
+
+    // view into a sorted run of target beats owned by a TimingTargetIndex
+    struct TimingTargetRange
+    {
+        const float* first = nullptr;
+        const float* last = nullptr;
+
+        const float* begin() const { return first; }
+        const float* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+    };
+
+    /////////////////////////
+    // Timing Target Index //
+    ///////////////////////////////////////////////////////////////
+    // Sorted, de-duplicated target beats for every timing mode, //
+    // built once per sequence. Window queries binary search the //
+    // first time, then walk forward from the last position.     //
+    ///////////////////////////////////////////////////////////////
+    class TimingTargetIndex
+    {
+    public:
+        void Clear();
+        void Build(const EventSequence& seq);
+        void EnsureBuilt(const EventSequence& seq);
+        bool IsBuiltFor(const EventSequence& seq) const;
+
+        // same window as CollectTimingTargets, without the copy
+        TimingTargetRange Query(TimingTargetMode mode, float current_beat, float lookahead_beats);
+
+        const std::vector<float>& GetTargets(TimingTargetMode mode) const;
+
+        static constexpr float lookback_beats = 0.5f;
+        static constexpr float merge_epsilon_beats = 0.0005f;
+
+    private:
+        // how far the cursor may walk before falling back to a binary search
+        static constexpr size_t max_cursor_steps = 16;
+
+        std::array<std::vector<float>, NumTimingTargetModes> m_targets;
+        std::array<size_t, NumTimingTargetModes> m_cursors{};
+
+        // EventSequence generation the targets were built from
+        uint64_t m_generation = 0;
+        bool m_built = false;
+    };
 }
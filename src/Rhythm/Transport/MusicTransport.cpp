@@ -4,13 +4,15 @@
 
 void MusicTransport::Reset()
 {
+    elapsed_seconds = 0.0;
     raw_seconds = 0.0f;
     visual_seconds = 0.0f;
 }
 
 void MusicTransport::Update(const float dt_sec)
 {
-    raw_seconds += dt_sec;
+    elapsed_seconds += dt_sec;
+    raw_seconds = static_cast<float>(elapsed_seconds);
     this->dt_seconds = dt_sec;
 
     // latency-compensated visual time
@@ -22,6 +24,12 @@ float MusicTransport::GetBeat() const
     return SecondsToBeats(visual_seconds, bpm);
 }
 
+// beat at a moment age_sec before the current transport time
+float MusicTransport::GetBeatBefore(const float age_sec) const
+{
+    return SecondsToBeats(MaxFloat(0.0f, visual_seconds - age_sec), bpm);
+}
+
 float MusicTransport::GetBeatInBar() const
 {
     return std::fmod(GetBeat(), static_cast<float>(beats_per_bar));
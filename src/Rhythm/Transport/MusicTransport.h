@@ -3,6 +3,8 @@
 struct MusicTransport
 {
     // raw & visual time
+    // (accumulated in double so thousands of small steps don't drift)
+    double elapsed_seconds = 0.0;
     float raw_seconds = 0.0f;
     float visual_seconds = 0.0f;
     float dt_seconds  = 0.0f;
@@ -21,6 +23,7 @@ struct MusicTransport
 
     // getters
     float GetBeat() const;
+    float GetBeatBefore(float age_sec) const;
     float GetBeatInBar() const;
     float GetBarProgress() const;
     int GetBarIndex() const;
@@ -0,0 +1,123 @@
+#include "Util/AllocTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // plain thread_locals: no constructor, so they are safe to touch from inside operator new
+    thread_local uint64_t t_allocations = 0;
+    thread_local uint64_t t_bytes = 0;
+
+    Rhythm::AllocTracker::Counts g_frame_start;
+    Rhythm::AllocTracker::Counts g_last_frame;
+    uint64_t g_allocating_frames = 0;
+}
+
+namespace Rhythm
+{
+    AllocTracker::Counts AllocTracker::GetThreadCounts()
+    {
+        Counts counts;
+        counts.allocations = t_allocations;
+        counts.bytes = t_bytes;
+        return counts;
+    }
+
+    void AllocTracker::EndFrame()
+    {
+        if (!enabled) return;
+
+        const Counts now = GetThreadCounts();
+        g_last_frame.allocations = now.allocations - g_frame_start.allocations;
+        g_last_frame.bytes = now.bytes - g_frame_start.bytes;
+        g_frame_start = now;
+
+        if (g_last_frame.allocations > 0) g_allocating_frames++;
+    }
+
+    const AllocTracker::Counts& AllocTracker::GetLastFrame()
+    {
+        return g_last_frame;
+    }
+
+    uint64_t AllocTracker::GetAllocatingFrames()
+    {
+        return g_allocating_frames;
+    }
+}
+
+#if BUILD_ALLOC_TRACKING
+
+/////////////////////////////
+// Global new replacements //
+/////////////////////////////////////////////////////////////
+// Lives in the same unit as the counters above, so using  //
+// the tracker is what pulls these into the link. Aligned  //
+// forms are left to the runtime and go uncounted.         //
+/////////////////////////////////////////////////////////////
+namespace
+{
+    void* TrackedAlloc(const std::size_t size)
+    {
+        t_allocations++;
+        t_bytes += size;
+        return std::malloc(size == 0 ? 1 : size);
+    }
+}
+
+void* operator new(const std::size_t size)
+{
+    void* memory = TrackedAlloc(size);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new[](const std::size_t size)
+{
+    void* memory = TrackedAlloc(size);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept
+{
+    return TrackedAlloc(size);
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept
+{
+    return TrackedAlloc(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    std::free(memory);
+}
+
+#endif
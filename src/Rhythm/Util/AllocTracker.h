@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+#ifndef BUILD_ALLOC_TRACKING
+#define BUILD_ALLOC_TRACKING 0
+#endif
+
+////////////////////////
+// Allocation Tracker //
+/////////////////////////////////////////////////////////////
+// With BUILD_ALLOC_TRACKING=1 the global operator new is  //
+// replaced by one that counts calls and bytes per thread. //
+// The frame loop reads the main thread's delta each frame //
+// and profiler zones record their own. Otherwise every    //
+// count reads zero and nothing is replaced.               //
+/////////////////////////////////////////////////////////////
+namespace Rhythm
+{
+    class AllocTracker
+    {
+    public:
+        struct Counts
+        {
+            uint64_t allocations = 0;
+            uint64_t bytes = 0;
+        };
+
+        static constexpr bool enabled = BUILD_ALLOC_TRACKING != 0;
+
+        // running totals for the calling thread
+        static Counts GetThreadCounts();
+
+        // called once per frame on the main thread
+        static void EndFrame();
+        static const Counts& GetLastFrame();
+
+        // frames since start that allocated anything on the main thread
+        static uint64_t GetAllocatingFrames();
+    };
+}
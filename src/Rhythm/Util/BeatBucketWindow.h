@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+////////////////////////
+// Beat Bucket Window //
+/////////////////////////////////////////////////////////////
+// Sliding-window set of beat buckets stored as a circular //
+// bitset. Buckets map to bit (bucket % Capacity); moving  //
+// the window clears only the words that changed meaning.  //
+/////////////////////////////////////////////////////////////
+namespace Rhythm
+{
+    template <uint32_t Capacity>
+    class BeatBucketWindow
+    {
+    public:
+        static_assert(Capacity >= 64 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two of at least 64");
+
+        static constexpr uint32_t capacity = Capacity;
+
+        void Clear()
+        {
+            m_words.fill(0);
+            m_first_bucket = 0;
+        }
+
+        // move the window to [first_bucket, first_bucket + capacity)
+        void Advance(const uint32_t first_bucket)
+        {
+            if (first_bucket == m_first_bucket) return;
+
+            // the positions of buckets entering the window still hold the ones leaving it
+            const bool forward = first_bucket > m_first_bucket;
+            const uint32_t shift = forward ? first_bucket - m_first_bucket : m_first_bucket - first_bucket;
+
+            if (shift >= capacity) m_words.fill(0);
+            else ClearBuckets(forward ? m_first_bucket : first_bucket, shift);
+
+            m_first_bucket = first_bucket;
+        }
+
+        bool InWindow(const uint32_t bucket) const
+        {
+            return bucket >= m_first_bucket && bucket - m_first_bucket < capacity;
+        }
+
+        bool Contains(const uint32_t bucket) const
+        {
+            if (!InWindow(bucket)) return false;
+
+            const uint32_t position = bucket & position_mask;
+            return (m_words[position >> 6] >> (position & 63)) & 1u;
+        }
+
+        // returns false if the bucket lies outside the window
+        bool Insert(const uint32_t bucket)
+        {
+            if (!InWindow(bucket)) return false;
+
+            const uint32_t position = bucket & position_mask;
+            m_words[position >> 6] |= uint64_t(1) << (position & 63);
+            return true;
+        }
+
+    private:
+        static constexpr uint32_t position_mask = Capacity - 1;
+
+        // clear a run of buckets a word at a time
+        void ClearBuckets(const uint32_t first_bucket, uint32_t count)
+        {
+            uint32_t position = first_bucket & position_mask;
+            while (count > 0)
+            {
+                const uint32_t bit = position & 63;
+                const uint32_t run = (64 - bit < count) ? 64 - bit : count;
+                const uint64_t run_mask = (run == 64) ? ~uint64_t(0) : ((uint64_t(1) << run) - 1) << bit;
+
+                m_words[position >> 6] &= ~run_mask;
+                position = (position + run) & position_mask;
+                count -= run;
+            }
+        }
+
+        std::array<uint64_t, Capacity / 64> m_words{};
+        uint32_t m_first_bucket = 0;
+    };
+}
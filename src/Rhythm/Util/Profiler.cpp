@@ -0,0 +1,384 @@
+#include "Util/Profiler.h"
+#include "Util/AllocTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    struct ZoneEvent
+    {
+        const char* name = nullptr;
+        uint64_t start_ns = 0;
+        uint64_t end_ns = 0;
+        uint32_t depth = 0;
+        uint32_t allocations = 0;
+        uint64_t allocated_bytes = 0;
+    };
+
+    // fields are relaxed atomics so a reader racing the owner gets stale or
+    // new values, never torn ones; ReadEvent throws away anything lapped
+    struct EventSlot
+    {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> start_ns{0};
+        std::atomic<uint64_t> end_ns{0};
+        std::atomic<uint32_t> depth{0};
+        std::atomic<uint32_t> allocations{0};
+        std::atomic<uint64_t> allocated_bytes{0};
+    };
+
+    // written only by its own thread; the main thread reads behind the published count
+    struct ThreadRing
+    {
+        EventSlot events[Rhythm::Profiler::ring_capacity];
+        std::atomic<uint64_t> written{0};
+        uint64_t frame_read = 0;
+        uint64_t first_event = 0; // events before this belong to an earlier owner
+        uint32_t thread_index = 0;
+        bool in_use = false;
+        char name[32] = {};
+    };
+
+    // readers stay this far behind the slot the owner writes next
+    constexpr uint64_t read_margin = 256;
+
+    std::atomic<bool> g_enabled{false};
+
+    // rings of exited threads wait in the free list for the next thread
+    std::mutex g_rings_mutex;
+    std::vector<std::unique_ptr<ThreadRing>> g_rings;
+    std::vector<ThreadRing*> g_free_rings;
+
+    void ReleaseThreadRing(ThreadRing* ring);
+
+    // hands the thread's ring back when the thread exits
+    struct ThreadRingLease
+    {
+        ThreadRing* ring = nullptr;
+        ~ThreadRingLease() { if (ring) ReleaseThreadRing(ring); }
+    };
+
+    thread_local ThreadRingLease t_lease;
+    thread_local uint32_t t_depth = 0;
+    thread_local char t_thread_name[32] = {};
+
+    const std::chrono::steady_clock::time_point g_epoch = std::chrono::steady_clock::now();
+
+    Rhythm::Profiler::FrameZone g_frame_zones[Rhythm::Profiler::max_frame_zones];
+    uint32_t g_frame_zone_threads[Rhythm::Profiler::max_frame_zones] = {};
+    uint64_t g_frame_zone_starts[Rhythm::Profiler::max_frame_zones] = {};
+    double g_frame_zone_ms[Rhythm::Profiler::max_frame_zones] = {};
+    size_t g_frame_zone_count = 0;
+
+    // zones that stop reporting are dropped from the display after this long
+    constexpr uint32_t max_idle_frames = 300;
+    constexpr float average_blend = 0.1f;
+
+    uint64_t NowNS()
+    {
+        // offset by one so a started zone is never 0
+        const auto elapsed = std::chrono::steady_clock::now() - g_epoch;
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) + 1;
+    }
+
+    // only called while capture is on, so threads that never record cost nothing
+    ThreadRing& GetThreadRing()
+    {
+        if (t_lease.ring) return *t_lease.ring;
+
+        std::lock_guard lock(g_rings_mutex);
+        ThreadRing* ring = nullptr;
+        if (!g_free_rings.empty())
+        {
+            ring = g_free_rings.back();
+            g_free_rings.pop_back();
+
+            // the last owner has exited, so its count is final
+            const uint64_t written = ring->written.load(std::memory_order_relaxed);
+            ring->first_event = written;
+            ring->frame_read = written;
+        }
+        else
+        {
+            g_rings.push_back(std::make_unique<ThreadRing>());
+            ring = g_rings.back().get();
+            ring->thread_index = static_cast<uint32_t>(g_rings.size() - 1);
+        }
+
+        ring->in_use = true;
+        if (t_thread_name[0] != '\0') (void)snprintf(ring->name, sizeof(ring->name), "%s", t_thread_name);
+        else (void)snprintf(ring->name, sizeof(ring->name), "Thread %u", ring->thread_index);
+
+        t_lease.ring = ring;
+        return *ring;
+    }
+
+    void ReleaseThreadRing(ThreadRing* ring)
+    {
+        std::lock_guard lock(g_rings_mutex);
+        ring->in_use = false;
+        g_free_rings.push_back(ring);
+    }
+
+    // first index still worth reading; the owner may be overwriting anything older
+    uint64_t OldestReadable(const ThreadRing& ring, const uint64_t written)
+    {
+        const uint64_t capacity = Rhythm::Profiler::ring_capacity;
+        const uint64_t oldest = (written > capacity - read_margin) ? written - (capacity - read_margin) : 0;
+        return (oldest > ring.first_event) ? oldest : ring.first_event;
+    }
+
+    // copies an event out, false if its owner lapped it while we read
+    bool ReadEvent(const ThreadRing& ring, const uint64_t read_index, ZoneEvent& event)
+    {
+        const EventSlot& slot = ring.events[read_index % Rhythm::Profiler::ring_capacity];
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.start_ns = slot.start_ns.load(std::memory_order_relaxed);
+        event.end_ns = slot.end_ns.load(std::memory_order_relaxed);
+        event.depth = slot.depth.load(std::memory_order_relaxed);
+        event.allocations = slot.allocations.load(std::memory_order_relaxed);
+        event.allocated_bytes = slot.allocated_bytes.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return read_index + Rhythm::Profiler::ring_capacity > ring.written.load(std::memory_order_relaxed);
+    }
+
+    size_t FindOrAddFrameZone(const ZoneEvent& event, const ThreadRing& ring)
+    {
+        for (size_t zone_index = 0; zone_index < g_frame_zone_count; ++zone_index)
+        {
+            if (g_frame_zones[zone_index].name == event.name && g_frame_zone_threads[zone_index] == ring.thread_index) return zone_index;
+        }
+
+        if (g_frame_zone_count >= Rhythm::Profiler::max_frame_zones) return Rhythm::Profiler::max_frame_zones;
+
+        const size_t zone_index = g_frame_zone_count++;
+        g_frame_zones[zone_index] = Rhythm::Profiler::FrameZone{};
+        g_frame_zones[zone_index].name = event.name;
+        g_frame_zones[zone_index].thread_name = ring.name;
+        g_frame_zone_threads[zone_index] = ring.thread_index;
+        g_frame_zone_starts[zone_index] = event.start_ns;
+        g_frame_zone_ms[zone_index] = 0.0;
+        return zone_index;
+    }
+
+    void SwapFrameZones(const size_t left, const size_t right)
+    {
+        std::swap(g_frame_zones[left], g_frame_zones[right]);
+        std::swap(g_frame_zone_threads[left], g_frame_zone_threads[right]);
+        std::swap(g_frame_zone_starts[left], g_frame_zone_starts[right]);
+        std::swap(g_frame_zone_ms[left], g_frame_zone_ms[right]);
+    }
+
+    void WriteJsonString(FILE* file, const char* text)
+    {
+        std::fputc('"', file);
+        for (const char* cursor = text; cursor && *cursor; ++cursor)
+        {
+            if (*cursor == '"' || *cursor == '\\') std::fputc('\\', file);
+            std::fputc(*cursor, file);
+        }
+        std::fputc('"', file);
+    }
+}
+
+namespace Rhythm
+{
+    void Profiler::SetEnabled(const bool enabled)
+    {
+        g_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool Profiler::IsEnabled()
+    {
+        return g_enabled.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::SetThreadName(const char* name)
+    {
+        (void)snprintf(t_thread_name, sizeof(t_thread_name), "%s", name);
+
+        if (!t_lease.ring) return;
+        std::lock_guard lock(g_rings_mutex);
+        (void)snprintf(t_lease.ring->name, sizeof(t_lease.ring->name), "%s", name);
+    }
+
+    Profiler::ZoneStart Profiler::BeginZone()
+    {
+        ++t_depth;
+
+        ZoneStart start;
+        const AllocTracker::Counts counts = AllocTracker::GetThreadCounts();
+        start.allocations = counts.allocations;
+        start.allocated_bytes = counts.bytes;
+        start.start_ns = NowNS();
+        return start;
+    }
+
+    void Profiler::EndZone(const char* name, const ZoneStart& start)
+    {
+        const uint64_t end_ns = NowNS();
+        const AllocTracker::Counts counts = AllocTracker::GetThreadCounts();
+        --t_depth;
+
+        ThreadRing& ring = GetThreadRing();
+        const uint64_t write_index = ring.written.load(std::memory_order_relaxed);
+
+        // pairs with the fence in ReadEvent: a reader that sees these bytes also sees the count that retired the old event
+        std::atomic_thread_fence(std::memory_order_release);
+
+        EventSlot& slot = ring.events[write_index % ring_capacity];
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.start_ns.store(start.start_ns, std::memory_order_relaxed);
+        slot.end_ns.store(end_ns, std::memory_order_relaxed);
+        slot.depth.store(t_depth, std::memory_order_relaxed);
+        slot.allocations.store(static_cast<uint32_t>(counts.allocations - start.allocations), std::memory_order_relaxed);
+        slot.allocated_bytes.store(counts.bytes - start.allocated_bytes, std::memory_order_relaxed);
+
+        ring.written.store(write_index + 1, std::memory_order_release);
+    }
+
+    void Profiler::EndFrame()
+    {
+        if (!IsEnabled()) return;
+
+        for (size_t zone_index = 0; zone_index < g_frame_zone_count; ++zone_index)
+        {
+            g_frame_zones[zone_index].calls = 0;
+            g_frame_zones[zone_index].allocations = 0;
+            g_frame_zones[zone_index].allocated_bytes = 0;
+            g_frame_zone_ms[zone_index] = 0.0;
+        }
+
+        {
+            std::lock_guard lock(g_rings_mutex);
+            for (const std::unique_ptr<ThreadRing>& ring : g_rings)
+            {
+                const uint64_t written = ring->written.load(std::memory_order_acquire);
+                if (!ring->in_use && ring->frame_read == written) continue;
+
+                // anything older than one lap has been overwritten
+                uint64_t read_index = ring->frame_read;
+                const uint64_t oldest = OldestReadable(*ring, written);
+                if (read_index < oldest) read_index = oldest;
+
+                for (; read_index < written; ++read_index)
+                {
+                    ZoneEvent event;
+                    if (!ReadEvent(*ring, read_index, event)) continue;
+
+                    const size_t zone_index = FindOrAddFrameZone(event, *ring);
+                    if (zone_index >= max_frame_zones) continue;
+
+                    FrameZone& zone = g_frame_zones[zone_index];
+                    if (zone.calls == 0) g_frame_zone_starts[zone_index] = event.start_ns;
+                    zone.depth = event.depth;
+                    zone.calls++;
+                    zone.allocations += event.allocations;
+                    zone.allocated_bytes += event.allocated_bytes;
+                    g_frame_zone_ms[zone_index] += static_cast<double>(event.end_ns - event.start_ns) / 1000000.0;
+                }
+
+                ring->frame_read = written;
+            }
+        }
+
+        size_t kept_count = 0;
+        for (size_t zone_index = 0; zone_index < g_frame_zone_count; ++zone_index)
+        {
+            FrameZone& zone = g_frame_zones[zone_index];
+            if (zone.calls > 0)
+            {
+                zone.last_ms = static_cast<float>(g_frame_zone_ms[zone_index]);
+                zone.average_ms = (zone.frames_idle > 0 || zone.average_ms == 0.0f)
+                    ? zone.last_ms
+                    : zone.average_ms + (zone.last_ms - zone.average_ms) * average_blend;
+                zone.frames_idle = 0;
+            }
+            else
+            {
+                zone.last_ms = 0.0f;
+                if (++zone.frames_idle > max_idle_frames) continue;
+            }
+
+            if (kept_count != zone_index) SwapFrameZones(kept_count, zone_index);
+            ++kept_count;
+        }
+        g_frame_zone_count = kept_count;
+
+        // thread, then start time, so parents list above their children
+        for (size_t zone_index = 1; zone_index < g_frame_zone_count; ++zone_index)
+        {
+            for (size_t sort_index = zone_index; sort_index > 0; --sort_index)
+            {
+                const bool thread_before = g_frame_zone_threads[sort_index] < g_frame_zone_threads[sort_index - 1];
+                const bool start_before = g_frame_zone_threads[sort_index] == g_frame_zone_threads[sort_index - 1] &&
+                                          g_frame_zone_starts[sort_index] < g_frame_zone_starts[sort_index - 1];
+                if (!thread_before && !start_before) break;
+                SwapFrameZones(sort_index, sort_index - 1);
+            }
+        }
+    }
+
+    size_t Profiler::GetFrameZoneCount()
+    {
+        return g_frame_zone_count;
+    }
+
+    const Profiler::FrameZone& Profiler::GetFrameZone(const size_t index)
+    {
+        return g_frame_zones[index < g_frame_zone_count ? index : 0];
+    }
+
+    bool Profiler::ExportChromeTrace(const char* path)
+    {
+        FILE* file = std::fopen(path, "wb");
+        if (!file) return false;
+
+        std::fputs("{\"traceEvents\":[\n", file);
+        bool first_event = true;
+
+        std::lock_guard lock(g_rings_mutex);
+        for (const std::unique_ptr<ThreadRing>& ring : g_rings)
+        {
+            const uint32_t thread_id = ring->thread_index + 1;
+
+            std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first_event ? "" : ",\n", thread_id);
+            WriteJsonString(file, ring->name);
+            std::fputs("}}", file);
+            first_event = false;
+
+            const uint64_t written = ring->written.load(std::memory_order_acquire);
+            for (uint64_t read_index = OldestReadable(*ring, written); read_index < written; ++read_index)
+            {
+                ZoneEvent event;
+                if (!ReadEvent(*ring, read_index, event)) continue;
+
+                // complete events, in microseconds
+                std::fputs(",\n{\"name\":", file);
+                WriteJsonString(file, event.name);
+                std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                             thread_id,
+                             static_cast<double>(event.start_ns) / 1000.0,
+                             static_cast<double>(event.end_ns - event.start_ns) / 1000.0);
+
+                if (AllocTracker::enabled)
+                {
+                    std::fprintf(file, ",\"args\":{\"allocations\":%u,\"bytes\":%llu}",
+                                 event.allocations,
+                                 static_cast<unsigned long long>(event.allocated_bytes));
+                }
+                std::fputc('}', file);
+            }
+        }
+
+        std::fputs("\n]}\n", file);
+        return std::fclose(file) == 0;
+    }
+}
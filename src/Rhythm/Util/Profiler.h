@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef BUILD_PROFILER
+#define BUILD_PROFILER 1
+#endif
+
+//////////////
+// Profiler //
+/////////////////////////////////////////////////////////////
+// Scoped timing zones. Each thread writes finished zones  //
+// into its own ring, so a worker never waits on the main  //
+// thread. While capture is off a zone costs one relaxed   //
+// load; with BUILD_PROFILER=0 it compiles away entirely.  //
+// A ring is made on a thread's first captured zone and    //
+// reused by the next thread once its owner exits.         //
+/////////////////////////////////////////////////////////////
+namespace Rhythm
+{
+    class Profiler
+    {
+    public:
+        static constexpr size_t ring_capacity = 16 * 1024;
+        static constexpr size_t max_frame_zones = 32;
+
+        // a zone's totals over the last frame, plus a smoothed view for display
+        struct FrameZone
+        {
+            const char* name = nullptr;
+            const char* thread_name = nullptr;
+            uint32_t depth = 0;
+            uint32_t calls = 0;
+            uint32_t allocations = 0;
+            uint64_t allocated_bytes = 0;
+            float last_ms = 0.0f;
+            float average_ms = 0.0f;
+            uint32_t frames_idle = 0;
+        };
+
+        static void SetEnabled(bool enabled);
+        static bool IsEnabled();
+
+        // shows up as the thread's row in exported traces
+        static void SetThreadName(const char* name);
+
+        // called once per frame on the main thread to gather every thread's zones
+        static void EndFrame();
+        static size_t GetFrameZoneCount();
+        static const FrameZone& GetFrameZone(size_t index);
+
+        // writes the captured rings in Chrome's trace event format (chrome://tracing, Perfetto)
+        static bool ExportChromeTrace(const char* path);
+
+        // used by ProfileZone; start_ns stays 0 while capture is off
+        struct ZoneStart
+        {
+            uint64_t start_ns = 0;
+            uint64_t allocations = 0;
+            uint64_t allocated_bytes = 0;
+        };
+
+        static ZoneStart BeginZone();
+        static void EndZone(const char* name, const ZoneStart& start);
+    };
+
+    class ProfileZone
+    {
+    public:
+        explicit ProfileZone(const char* name) : m_name(name)
+        {
+            if (Profiler::IsEnabled()) m_start = Profiler::BeginZone();
+        }
+
+        ~ProfileZone()
+        {
+            if (m_start.start_ns != 0) Profiler::EndZone(m_name, m_start);
+        }
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+
+    private:
+        const char* m_name;
+        Profiler::ZoneStart m_start;
+    };
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if BUILD_PROFILER
+// name must be a string literal (or otherwise outlive the capture)
+#define PROFILE_ZONE(name) const Rhythm::ProfileZone PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif